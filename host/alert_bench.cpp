@@ -0,0 +1,108 @@
+// Measures AlertEngine cost with a large rule set: 500 rules over four
+// vitals, a mix of level and rate rules with hysteresis and sustain times.
+//
+//   owlet_alert_bench [samples]
+//
+// Prints the mean cost per sample, the latency distribution of individual
+// on_sample() calls and the delay from a sample arriving to its alert
+// callback firing.
+#include "alert_engine.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kRules = 500;
+const char* const kProperties[] = {"HEART_RATE", "OXYGEN_LEVEL", "SOCK_OFF", "MOVEMENT"};
+constexpr size_t kSignals = sizeof(kProperties) / sizeof(kProperties[0]);
+
+std::vector<AlertRule> make_rules() {
+    std::vector<AlertRule> rules;
+    for (size_t i = 0; i < kRules; ++i) {
+        AlertRule rule;
+        rule.name = "rule_" + std::to_string(i);
+        rule.property = kProperties[i % kSignals];
+        bool above = i % 2 != 0;
+        rule.condition = above ? AlertCondition::Above : AlertCondition::Below;
+        rule.trigger = above ? 150.0f + i % 50 : 80.0f - i % 30;
+        rule.clear = rule.trigger + (above ? -2.0f : 2.0f);
+        rule.sustain_seconds = i % 10;
+        rule.metric = i % 5 == 0 ? AlertMetric::Rate : AlertMetric::Value;
+        rule.rate_window_seconds = 1 + i % 3;
+        rules.push_back(rule);
+    }
+    return rules;
+}
+
+double ns_between(Clock::time_point a, Clock::time_point b) {
+    return std::chrono::duration<double, std::nano>(b - a).count();
+}
+
+double percentile(std::vector<double>& values, double p) {
+    if (values.empty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[(size_t)(p * (values.size() - 1))];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t samples = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000000;
+
+    AlertEngine engine;
+    OwletStatus compiled = engine.compile(make_rules());
+    if (!compiled) {
+        std::fprintf(stderr, "compile failed: %s\n", compiled.error().what());
+        return 1;
+    }
+
+    // Deterministic signal that keeps crossing the rule levels
+    std::vector<float> values(samples);
+    for (size_t i = 0; i < samples; ++i) {
+        values[i] = 60.0f + (float)((i * 7919) % 140);
+    }
+
+    // Throughput: nothing but on_sample() in the loop
+    size_t events = 0;
+    engine.set_callback([&](const AlertEvent&) { ++events; });
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < samples; ++i) {
+        OwletStatus status = engine.on_sample((uint16_t)(i % kSignals), (uint32_t)(i / kSignals), values[i]);
+        (void)status;
+    }
+    double mean_ns = ns_between(start, Clock::now()) / samples;
+
+    // Latency: time every 64th call on its own, and the delay to each callback
+    engine.reset();
+    std::vector<double> call_ns;
+    std::vector<double> callback_ns;
+    call_ns.reserve(samples / 64 + 1);
+    callback_ns.reserve(events);
+    Clock::time_point arrived;
+    engine.set_callback([&](const AlertEvent&) { callback_ns.push_back(ns_between(arrived, Clock::now())); });
+    for (size_t i = 0; i < samples; ++i) {
+        arrived = Clock::now();
+        OwletStatus status = engine.on_sample((uint16_t)(i % kSignals), (uint32_t)(i / kSignals), values[i]);
+        (void)status;
+        if (i % 64 == 0) {
+            call_ns.push_back(ns_between(arrived, Clock::now()));
+        }
+    }
+
+    std::printf("%u rules over %u properties, %u samples, %u alert events\n", (unsigned)engine.rule_count(),
+                (unsigned)kSignals, (unsigned)samples, (unsigned)events);
+    std::printf("on_sample mean %.1f ns\n", mean_ns);
+    std::printf("on_sample p50 %.0f ns, p99 %.0f ns, max %.0f ns\n", percentile(call_ns, 0.50),
+                percentile(call_ns, 0.99), percentile(call_ns, 1.0));
+    std::printf("sample to callback p50 %.0f ns, p99 %.0f ns, max %.0f ns\n", percentile(callback_ns, 0.50),
+                percentile(callback_ns, 0.99), percentile(callback_ns, 1.0));
+    return 0;
+}
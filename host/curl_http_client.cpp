@@ -0,0 +1,93 @@
+#include "curl_http_client.h"
+#include "esp_log.h"
+#include <utility>
+
+static const char* TAG = "CURL_HTTP_CLIENT";
+
+static constexpr long kTimeoutMs = 30000;
+
+CurlHttpClient::CurlHttpClient() : curl_(curl_easy_init()) {
+    if (!curl_) {
+        ESP_LOGE(TAG, "Failed to initialize libcurl handle");
+    }
+    ESP_LOGI(TAG, "Curl HTTP Client initialized");
+}
+
+CurlHttpClient::~CurlHttpClient() {
+    if (curl_) {
+        curl_easy_cleanup(curl_);
+    }
+    ESP_LOGI(TAG, "Curl HTTP Client destroyed");
+}
+
+void CurlHttpClient::set_chunk_callback(ChunkCallback callback) {
+    chunk_callback_ = std::move(callback);
+}
+
+size_t CurlHttpClient::on_data(char* data, size_t size, size_t count, void* user) {
+    CurlHttpClient* self = static_cast<CurlHttpClient*>(user);
+    size_t len = size * count;
+    self->response_data_.append(data, len);
+    if (self->chunk_callback_) {
+        self->chunk_callback_(data, len);
+    }
+    return len;
+}
+
+OwletResult<std::string> CurlHttpClient::perform(bool post, const std::string& url, const std::string& data,
+                                                 const std::map<std::string, std::string>& headers) {
+    if (!curl_) {
+        return owlet_error(OwletErrc::ClientInitFailed, "Failed to initialize HTTP client");
+    }
+
+    curl_slist* header_list = nullptr;
+    for (const auto& header : headers) {
+        header_list = curl_slist_append(header_list, (header.first + ": " + header.second).c_str());
+    }
+
+    curl_easy_setopt(curl_, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl_, CURLOPT_HTTPHEADER, header_list);
+    curl_easy_setopt(curl_, CURLOPT_WRITEFUNCTION, &CurlHttpClient::on_data);
+    curl_easy_setopt(curl_, CURLOPT_WRITEDATA, this);
+    curl_easy_setopt(curl_, CURLOPT_TIMEOUT_MS, kTimeoutMs);
+    if (post) {
+        curl_easy_setopt(curl_, CURLOPT_POSTFIELDS, data.c_str());
+        curl_easy_setopt(curl_, CURLOPT_POSTFIELDSIZE, (long)data.size());
+    } else {
+        curl_easy_setopt(curl_, CURLOPT_HTTPGET, 1L);
+    }
+
+    // Reset request state
+    response_data_.clear();
+
+    CURLcode err = curl_easy_perform(curl_);
+    // The handle outlives this call; don't leave it pointing at our headers
+    curl_easy_setopt(curl_, CURLOPT_HTTPHEADER, nullptr);
+    curl_slist_free_all(header_list);
+
+    if (err != CURLE_OK) {
+        ESP_LOGE(TAG, "HTTP %s request failed: %s", post ? "POST" : "GET", curl_easy_strerror(err));
+        return owlet_error(OwletErrc::ConnectionFailed,
+                           post ? "HTTP POST request failed" : "HTTP GET request failed", (int)err);
+    }
+
+    long status_code = 0;
+    curl_easy_getinfo(curl_, CURLINFO_RESPONSE_CODE, &status_code);
+    ESP_LOGI(TAG, "HTTP %s Status = %ld", post ? "POST" : "GET", status_code);
+    if (status_code < 200 || status_code >= 300) {
+        return owlet_error(OwletErrc::HttpStatus,
+                           post ? "HTTP POST returned non-2xx status" : "HTTP GET returned non-2xx status",
+                           (int)status_code);
+    }
+    return std::move(response_data_);
+}
+
+OwletResult<std::string> CurlHttpClient::post(const std::string& url, const std::string& data,
+                                              const std::map<std::string, std::string>& headers) {
+    return perform(true, url, data, headers);
+}
+
+OwletResult<std::string> CurlHttpClient::get(const std::string& url,
+                                             const std::map<std::string, std::string>& headers) {
+    return perform(false, url, std::string(), headers);
+}
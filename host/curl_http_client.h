@@ -0,0 +1,32 @@
+#pragma once
+
+#include "http_client.h"
+#include <curl/curl.h>
+#include <string>
+#include <map>
+
+// HttpClient over libcurl, so host tools can talk to the real Owlet cloud.
+// Like EspHttpClient it keeps one handle, and with it one kept-alive
+// connection, for every request. An instance must only be used by one
+// thread at a time; call curl_global_init() before creating the first one.
+class CurlHttpClient : public HttpClient {
+public:
+    CurlHttpClient();
+    ~CurlHttpClient() override;
+
+    OwletResult<std::string> post(const std::string& url, const std::string& data,
+                                  const std::map<std::string, std::string>& headers) override;
+    OwletResult<std::string> get(const std::string& url,
+                                 const std::map<std::string, std::string>& headers) override;
+    void set_chunk_callback(ChunkCallback callback) override;
+
+private:
+    static size_t on_data(char* data, size_t size, size_t count, void* user);
+
+    OwletResult<std::string> perform(bool post, const std::string& url, const std::string& data,
+                                     const std::map<std::string, std::string>& headers);
+
+    CURL* curl_;
+    std::string response_data_;
+    ChunkCallback chunk_callback_;
+};
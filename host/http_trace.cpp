@@ -0,0 +1,298 @@
+#include "http_trace.h"
+#include "esp_log.h"
+#include <cstring>
+#include <climits>
+
+static const char* TAG = "HTTP_TRACE";
+
+static const char kTraceMagic[4] = {'O', 'W', 'T', 'R'};
+static constexpr uint8_t kTraceVersion = 1;
+// Highest values a trace may hold; keep in step with the enums
+static constexpr uint8_t kLastMethod = (uint8_t)HttpMethod::Post;
+static constexpr uint8_t kLastErrc = (uint8_t)OwletErrc::StorageFailed;
+// A request longer than this is a corrupt trace, not a slow server; it also
+// bounds how long a 1x replay can sleep
+static constexpr uint64_t kMaxDurationUs = 10ULL * 60 * 1000000;
+
+// JSON string fields and form fields masked by http_redact_secrets() and
+// left out of http_body_hash()
+static const char* const kSecretFields[] = {
+    "password", "idToken", "refreshToken", "id_token", "access_token", "refresh_token",
+    "auth_token", "api_token", "mini_token",
+};
+
+namespace {
+
+void put_varint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back((char)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((char)value);
+}
+
+void put_zigzag(std::string& out, int64_t value) {
+    put_varint(out, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+class TraceReader {
+public:
+    TraceReader(const std::string& data) : data_(data), pos_(0), ok_(true) {}
+
+    bool ok() const { return ok_; }
+    bool done() const { return pos_ >= data_.size(); }
+
+    uint8_t byte() {
+        if (pos_ >= data_.size()) {
+            ok_ = false;
+            return 0;
+        }
+        return (uint8_t)data_[pos_++];
+    }
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            uint8_t b = byte();
+            value |= (uint64_t)(b & 0x7F) << shift;
+            if (!(b & 0x80)) {
+                return value;
+            }
+        }
+        ok_ = false;
+        return 0;
+    }
+
+    int64_t zigzag() {
+        uint64_t value = varint();
+        return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+    }
+
+    size_t remaining() const { return data_.size() - pos_; }
+
+    bool bytes(std::string& out, uint64_t len) {
+        if (len > remaining()) {
+            ok_ = false;
+            return false;
+        }
+        out.assign(data_, pos_, (size_t)len);
+        pos_ += (size_t)len;
+        return true;
+    }
+
+private:
+    const std::string& data_;
+    size_t pos_;
+    bool ok_;
+};
+
+// Replaces the value of every secret field in a form-encoded body with '*'
+void mask_form_secrets(std::string& body) {
+    for (const char* field : kSecretFields) {
+        std::string key = std::string(field) + "=";
+        for (size_t pos = body.find(key); pos != std::string::npos; pos = body.find(key, pos + 1)) {
+            if (pos > 0 && body[pos - 1] != '&') {
+                continue;
+            }
+            size_t start = pos + key.size();
+            size_t end = body.find('&', start);
+            body.replace(start, (end == std::string::npos ? body.size() : end) - start, "*");
+        }
+    }
+}
+
+} // namespace
+
+uint64_t http_body_hash(const std::string& body) {
+    // Secrets are masked first: FNV-1a is fast enough that a hashed sign-in
+    // body would give up the password to offline guessing
+    std::string masked = body;
+    if (!masked.empty()) {
+        http_redact_secrets(masked);
+        mask_form_secrets(masked);
+    }
+
+    // FNV-1a
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : masked) {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+void http_redact_secrets(std::string& body) {
+    for (const char* field : kSecretFields) {
+        std::string key = std::string("\"") + field + "\"";
+        for (size_t pos = body.find(key); pos != std::string::npos; pos = body.find(key, pos)) {
+            pos += key.size();
+            size_t colon = body.find_first_not_of(" \t\r\n", pos);
+            if (colon == std::string::npos || body[colon] != ':') {
+                continue;
+            }
+            size_t quote = body.find_first_not_of(" \t\r\n", colon + 1);
+            if (quote == std::string::npos || body[quote] != '"') {
+                continue;
+            }
+            // Mask in place up to the closing quote, keeping the length
+            for (pos = quote + 1; pos < body.size() && body[pos] != '"'; ++pos) {
+                if (body[pos] == '\\' && pos + 1 < body.size()) {
+                    body[pos++] = '*';
+                }
+                body[pos] = '*';
+            }
+        }
+    }
+}
+
+HttpTraceWriter::HttpTraceWriter(const std::string& path) : file_(nullptr), last_start_us_(0) {
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        ESP_LOGE(TAG, "Failed to open trace %s", path.c_str());
+        return;
+    }
+    std::fwrite(kTraceMagic, 1, sizeof(kTraceMagic), file_);
+    std::fputc(kTraceVersion, file_);
+    ESP_LOGI(TAG, "Recording HTTP trace to %s", path.c_str());
+}
+
+HttpTraceWriter::~HttpTraceWriter() {
+    if (file_) {
+        std::fclose(file_);
+    }
+}
+
+OwletStatus HttpTraceWriter::append(const HttpExchange& exchange) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_) {
+        return owlet_error(OwletErrc::StorageFailed, "Trace file not open");
+    }
+
+    buffer_.clear();
+    buffer_.push_back((char)exchange.method);
+    buffer_.push_back((char)exchange.result);
+    put_zigzag(buffer_, exchange.detail);
+    // Exchanges are appended as they complete, so starts can go backwards
+    put_zigzag(buffer_, exchange.start_us - last_start_us_);
+    last_start_us_ = exchange.start_us;
+    put_varint(buffer_, (uint64_t)exchange.duration_us);
+    put_varint(buffer_, exchange.url.size());
+    buffer_ += exchange.url;
+    for (int i = 0; i < 8; ++i) {
+        buffer_.push_back((char)(exchange.body_hash >> (8 * i)));
+    }
+    put_varint(buffer_, exchange.chunks.size());
+    int64_t previous = 0;
+    for (const HttpChunk& chunk : exchange.chunks) {
+        put_varint(buffer_, (uint64_t)(chunk.offset_us - previous));
+        put_varint(buffer_, chunk.length);
+        previous = chunk.offset_us;
+    }
+    buffer_ += exchange.response;
+
+    if (std::fwrite(buffer_.data(), 1, buffer_.size(), file_) != buffer_.size()) {
+        ESP_LOGE(TAG, "Failed to write trace record");
+        return owlet_error(OwletErrc::StorageFailed, "Trace write failed");
+    }
+    return {};
+}
+
+OwletStatus HttpTraceWriter::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_ || std::fflush(file_) != 0) {
+        return owlet_error(OwletErrc::StorageFailed, "Trace flush failed");
+    }
+    return {};
+}
+
+OwletResult<std::vector<HttpExchange>> load_http_trace(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        ESP_LOGE(TAG, "Failed to open trace %s", path.c_str());
+        return owlet_error(OwletErrc::StorageFailed, "Trace file not found");
+    }
+    std::string data;
+    char block[512];
+    size_t n;
+    while ((n = std::fread(block, 1, sizeof(block), file)) > 0) {
+        data.append(block, n);
+    }
+    std::fclose(file);
+
+    if (data.size() < sizeof(kTraceMagic) + 1 ||
+        std::memcmp(data.data(), kTraceMagic, sizeof(kTraceMagic)) != 0 ||
+        (uint8_t)data[sizeof(kTraceMagic)] != kTraceVersion) {
+        return owlet_error(OwletErrc::InvalidResponse, "Not an HTTP trace file");
+    }
+
+    std::vector<HttpExchange> exchanges;
+    TraceReader reader(data);
+    std::string skip;
+    reader.bytes(skip, sizeof(kTraceMagic) + 1);
+    int64_t start = 0;
+    while (!reader.done()) {
+        HttpExchange exchange;
+        uint8_t method = reader.byte();
+        uint8_t result = reader.byte();
+        if (method > kLastMethod || result > kLastErrc) {
+            ESP_LOGE(TAG, "Trace %s has an unknown method or result after %u exchanges",
+                     path.c_str(), (unsigned)exchanges.size());
+            return owlet_error(OwletErrc::InvalidResponse, "Corrupt HTTP trace");
+        }
+        exchange.method = (HttpMethod)method;
+        exchange.result = (OwletErrc)result;
+        int64_t detail = reader.zigzag();
+        int64_t start_delta = reader.zigzag();
+        uint64_t duration = reader.varint();
+        if (detail < INT_MIN || detail > INT_MAX || duration > kMaxDurationUs ||
+            (start_delta > 0 && start > INT64_MAX - start_delta) ||
+            (start_delta < 0 && start < INT64_MIN - start_delta)) {
+            ESP_LOGE(TAG, "Trace %s has an out-of-range field after %u exchanges",
+                     path.c_str(), (unsigned)exchanges.size());
+            return owlet_error(OwletErrc::InvalidResponse, "Corrupt HTTP trace");
+        }
+        exchange.detail = (int)detail;
+        start += start_delta;
+        exchange.start_us = start;
+        exchange.duration_us = (int64_t)duration;
+        reader.bytes(exchange.url, reader.varint());
+        exchange.body_hash = 0;
+        for (int i = 0; i < 8; ++i) {
+            exchange.body_hash |= (uint64_t)reader.byte() << (8 * i);
+        }
+
+        // Replay hands out response slices by chunk length, so the chunks
+        // must cover the response exactly. Every chunk takes at least two
+        // bytes, and the running total is checked against the bytes left,
+        // so neither the count nor the sum can overflow. Offsets only move
+        // forward and stay within the request's duration.
+        uint64_t chunk_count = reader.varint();
+        bool valid = chunk_count <= reader.remaining() / 2;
+        uint64_t total = 0;
+        uint64_t offset = 0;
+        for (uint64_t i = 0; i < chunk_count && valid && reader.ok(); ++i) {
+            uint64_t offset_delta = reader.varint();
+            uint64_t length = reader.varint();
+            valid = offset_delta <= duration - offset;
+            offset += valid ? offset_delta : 0;
+            total += length;
+            valid = valid && length <= UINT32_MAX && total <= reader.remaining();
+            exchange.chunks.push_back(HttpChunk{(int64_t)offset, (uint32_t)length});
+        }
+        if (!valid) {
+            ESP_LOGE(TAG, "Trace %s has inconsistent chunks after %u exchanges",
+                     path.c_str(), (unsigned)exchanges.size());
+            return owlet_error(OwletErrc::InvalidResponse, "Corrupt HTTP trace");
+        }
+        reader.bytes(exchange.response, total);
+
+        if (!reader.ok()) {
+            ESP_LOGE(TAG, "Trace %s is truncated after %u exchanges", path.c_str(), (unsigned)exchanges.size());
+            return owlet_error(OwletErrc::InvalidResponse, "Truncated HTTP trace");
+        }
+        exchanges.push_back(std::move(exchange));
+    }
+
+    ESP_LOGI(TAG, "Loaded %u exchanges from %s", (unsigned)exchanges.size(), path.c_str());
+    return exchanges;
+}
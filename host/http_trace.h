@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <mutex>
+#include "owlet_result.h"
+
+enum class HttpMethod : uint8_t {
+    Get = 0,
+    Post = 1,
+};
+
+struct HttpChunk {
+    int64_t offset_us;      // arrival time relative to the request start
+    uint32_t length;
+};
+
+// One recorded request/response. Request headers are not kept, and the
+// request body is kept only as http_body_hash(), which leaves out passwords
+// and tokens. Responses are stored as received apart from the token fields
+// masked by http_redact_secrets(); URLs, device serials, account details
+// and vitals are kept, so treat traces as private.
+struct HttpExchange {
+    HttpMethod method;
+    std::string url;
+    uint64_t body_hash;
+    OwletErrc result;
+    int detail;
+    int64_t start_us;       // relative to the start of the trace
+    int64_t duration_us;
+    std::vector<HttpChunk> chunks;
+    std::string response;
+};
+
+// FNV-1a of a request body with password and token values masked, so
+// sign-in requests still match on replay without the hash exposing them
+uint64_t http_body_hash(const std::string& body);
+// Masks the values of known token fields in a JSON body with '*', keeping
+// its length so recorded chunk boundaries still line up
+void http_redact_secrets(std::string& body);
+
+// Appends exchanges to a compact binary trace file:
+//   "OWTR" version:u8, then per exchange
+//   method:u8 result:u8 detail:zigzag start_delta:zigzag duration:varint
+//   url_len:varint url body_hash:u64le chunk_count:varint
+//   (offset_delta:varint length:varint)* response bytes
+// Safe to share between several recording clients.
+class HttpTraceWriter {
+public:
+    explicit HttpTraceWriter(const std::string& path);
+    ~HttpTraceWriter();
+
+    bool is_open() const { return file_ != nullptr; }
+    OwletStatus append(const HttpExchange& exchange);
+    OwletStatus flush();
+
+private:
+    std::FILE* file_;
+    int64_t last_start_us_;
+    std::string buffer_;
+    std::mutex mutex_;
+};
+
+OwletResult<std::vector<HttpExchange>> load_http_trace(const std::string& path);
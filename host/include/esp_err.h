@@ -0,0 +1,17 @@
+#pragma once
+
+// Host stand-in for the ESP-IDF error codes used by the portable sources
+typedef int esp_err_t;
+
+#define ESP_OK              0
+#define ESP_FAIL            -1
+#define ESP_ERR_NOT_FOUND   0x105
+
+inline const char* esp_err_to_name(esp_err_t code) {
+    switch (code) {
+        case ESP_OK:            return "ESP_OK";
+        case ESP_FAIL:          return "ESP_FAIL";
+        case ESP_ERR_NOT_FOUND: return "ESP_ERR_NOT_FOUND";
+        default:                return "UNKNOWN ERROR";
+    }
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+// Host stand-in for the ESP-IDF logger. Warnings and errors go to stderr;
+// info and debug output is compiled out so it does not skew load numbers,
+// but the format strings are still type-checked.
+#include <cstdio>
+
+#define ESP_HOST_LOG(letter, tag, format, ...) \
+    std::fprintf(stderr, letter " (%s) " format "\n", tag, ##__VA_ARGS__)
+
+#define ESP_LOGE(tag, format, ...) ESP_HOST_LOG("E", tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) ESP_HOST_LOG("W", tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) do { if (0) ESP_HOST_LOG("I", tag, format, ##__VA_ARGS__); } while (0)
+#define ESP_LOGD(tag, format, ...) do { if (0) ESP_HOST_LOG("D", tag, format, ##__VA_ARGS__); } while (0)
+#define ESP_LOGV(tag, format, ...) do { if (0) ESP_HOST_LOG("V", tag, format, ##__VA_ARGS__); } while (0)
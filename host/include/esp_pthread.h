@@ -0,0 +1,27 @@
+#pragma once
+
+// Host stand-in for esp_pthread. Host threads size their own stacks, so
+// the config is accepted and otherwise ignored.
+#include <cstddef>
+#include "esp_err.h"
+
+typedef struct {
+    size_t stack_size;
+    size_t prio;
+    bool inherit_cfg;
+    const char* thread_name;
+    int pin_to_core;
+} esp_pthread_cfg_t;
+
+inline esp_pthread_cfg_t esp_pthread_get_default_config() {
+    return esp_pthread_cfg_t{3072, 5, false, nullptr, -1};
+}
+
+inline esp_err_t esp_pthread_set_cfg(const esp_pthread_cfg_t* cfg) {
+    return cfg ? ESP_OK : ESP_FAIL;
+}
+
+inline esp_err_t esp_pthread_get_cfg(esp_pthread_cfg_t* cfg) {
+    (void)cfg;
+    return ESP_ERR_NOT_FOUND;
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+// Host stand-in for esp_timer: microseconds on a monotonic clock
+#include <chrono>
+#include <cstdint>
+
+inline int64_t esp_timer_get_time() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
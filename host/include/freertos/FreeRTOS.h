@@ -0,0 +1,9 @@
+#pragma once
+
+// Host stand-in for the FreeRTOS types pulled in by owlet_api.h; one tick
+// is one millisecond
+#include <cstdint>
+
+typedef uint32_t TickType_t;
+
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <chrono>
+#include <thread>
+#include "freertos/FreeRTOS.h"
+
+inline void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
@@ -0,0 +1,90 @@
+#include "load_harness.h"
+#include "owlet_api.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+static const char* TAG = "LOAD_HARNESS";
+
+LoadHarness::LoadHarness(ClientFactory factory, OwletAccountConfig account)
+    : factory_(std::move(factory)), account_(std::move(account)) {}
+
+LoadReport LoadHarness::run(const LoadScenario& scenario) {
+    size_t threads = scenario.threads ? scenario.threads : 1;
+    size_t per_iteration = (scenario.authenticate ? 1 : 0) + (scenario.get_devices ? 1 : 0) +
+                           scenario.devices.size();
+
+    // Latencies are preallocated so the measured loop does not allocate for them
+    std::vector<std::vector<int64_t>> latencies(threads);
+    std::vector<size_t> errors(threads, 0);
+    std::vector<std::unique_ptr<OwletAPI>> apis;
+    for (size_t t = 0; t < threads; ++t) {
+        latencies[t].reserve(scenario.iterations * per_iteration);
+        apis.emplace_back(new OwletAPI(account_.region, account_.user, account_.password,
+                                       account_.token, account_.expiry, account_.refresh, factory_()));
+    }
+
+    auto worker = [&](size_t t) {
+        OwletAPI& api = *apis[t];
+        std::vector<int64_t>& samples = latencies[t];
+        auto timed = [&](bool ok, int64_t start) {
+            samples.push_back(esp_timer_get_time() - start);
+            if (!ok) {
+                ++errors[t];
+            }
+        };
+
+        for (size_t i = 0; i < scenario.iterations; ++i) {
+            if (scenario.authenticate) {
+                int64_t start = esp_timer_get_time();
+                timed((bool)api.authenticate(), start);
+            }
+            if (scenario.get_devices) {
+                int64_t start = esp_timer_get_time();
+                timed((bool)api.get_devices(), start);
+            }
+            for (const std::string& device : scenario.devices) {
+                int64_t start = esp_timer_get_time();
+                timed((bool)api.get_properties(device), start);
+            }
+        }
+    };
+
+    int64_t start = esp_timer_get_time();
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < threads; ++t) {
+        workers.emplace_back(worker, t);
+    }
+    worker(0);
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+    int64_t elapsed = esp_timer_get_time() - start;
+
+    std::vector<int64_t> all;
+    all.reserve(threads * scenario.iterations * per_iteration);
+    LoadReport report = {};
+    for (size_t t = 0; t < threads; ++t) {
+        all.insert(all.end(), latencies[t].begin(), latencies[t].end());
+        report.errors += errors[t];
+    }
+    std::sort(all.begin(), all.end());
+
+    auto percentile = [&all](double p) -> int64_t {
+        return all.empty() ? 0 : all[(size_t)(p * (all.size() - 1))];
+    };
+    report.operations = all.size();
+    report.seconds = elapsed / 1e6;
+    report.operations_per_second = report.seconds > 0 ? report.operations / report.seconds : 0;
+    report.p50_us = percentile(0.50);
+    report.p90_us = percentile(0.90);
+    report.p99_us = percentile(0.99);
+    report.max_us = all.empty() ? 0 : all.back();
+
+    ESP_LOGI(TAG, "%u ops in %.3f s (%.0f ops/s), p50 %lld us, p99 %lld us, %u errors",
+             (unsigned)report.operations, report.seconds, report.operations_per_second,
+             (long long)report.p50_us, (long long)report.p99_us, (unsigned)report.errors);
+    return report;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include "http_client.h"
+#include "owlet_manager.h"
+
+struct LoadScenario {
+    size_t threads = 1;
+    size_t iterations = 100;            // per thread
+    bool authenticate = true;
+    bool get_devices = true;
+    std::vector<std::string> devices;   // get_properties for each, every iteration
+};
+
+struct LoadReport {
+    size_t operations;
+    size_t errors;
+    double seconds;
+    double operations_per_second;
+    int64_t p50_us;
+    int64_t p90_us;
+    int64_t p99_us;
+    int64_t max_us;
+};
+
+// Drives OwletAPI calls in a loop from several threads and reports
+// throughput and per-call latency. Paired with ReplayHttpClient at speed 0
+// it gives repeatable numbers for comparing changes on the host.
+class LoadHarness {
+public:
+    using ClientFactory = std::function<std::shared_ptr<HttpClient>()>;
+
+    // `factory` is called once per thread; return a shared client to load
+    // one transport from every thread
+    LoadHarness(ClientFactory factory, OwletAccountConfig account);
+
+    LoadReport run(const LoadScenario& scenario);
+
+private:
+    ClientFactory factory_;
+    OwletAccountConfig account_;
+};
@@ -0,0 +1,131 @@
+// Replays an HTTP trace through OwletAPI at several speeds and thread
+// counts and prints throughput and latency for each run.
+//
+//   owlet_load_test                     record a synthetic trace, then replay it
+//   owlet_load_test trace [device...]   replay a trace made by owlet_record
+//
+// Requests are matched on their body hash, which covers the account email
+// but not the password, so pass the recording's OWLET_REGION and OWLET_USER.
+#include "recording_http_client.h"
+#include "replay_http_client.h"
+#include "load_harness.h"
+#include "esp_log.h"
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include <utility>
+
+static const char* TAG = "LOAD_TEST";
+
+static const char* kSyntheticTrace = "owlet_synthetic.trace";
+
+namespace {
+
+// Stands in for the cloud while recording the synthetic trace: every
+// response arrives in two chunks after a few milliseconds
+class SyntheticServer : public HttpClient {
+public:
+    OwletResult<std::string> post(const std::string& url, const std::string& data,
+                                  const std::map<std::string, std::string>& headers) override {
+        (void)data;
+        return get(url, headers);
+    }
+
+    OwletResult<std::string> get(const std::string& url,
+                                 const std::map<std::string, std::string>& headers) override {
+        (void)headers;
+        std::string body = "{\"url\":\"" + url + "\",\"idToken\":\"synthetic\",\"payload\":\"" +
+                           std::string(300, 'x') + "\"}";
+        size_t half = body.size() / 2;
+        std::this_thread::sleep_for(std::chrono::milliseconds(3));
+        if (chunk_callback_) {
+            chunk_callback_(body.data(), half);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        if (chunk_callback_) {
+            chunk_callback_(body.data() + half, body.size() - half);
+        }
+        return body;
+    }
+
+    void set_chunk_callback(ChunkCallback callback) override {
+        chunk_callback_ = std::move(callback);
+    }
+
+private:
+    ChunkCallback chunk_callback_;
+};
+
+const char* env_or(const char* name, const char* fallback) {
+    const char* value = std::getenv(name);
+    return value ? value : fallback;
+}
+
+OwletStatus record_synthetic(const OwletAccountConfig& account, const LoadScenario& scenario) {
+    auto writer = std::make_shared<HttpTraceWriter>(kSyntheticTrace);
+    if (!writer->is_open()) {
+        return owlet_error(OwletErrc::StorageFailed, "Cannot create synthetic trace");
+    }
+    auto recorder = std::make_shared<RecordingHttpClient>(std::make_shared<SyntheticServer>(), writer);
+    LoadHarness harness([&] { return recorder; }, account);
+    LoadScenario once = scenario;
+    once.threads = 1;
+    once.iterations = 1;
+    LoadReport report = harness.run(once);
+    if (report.errors) {
+        return owlet_error(OwletErrc::InvalidResponse, "Synthetic recording had errors");
+    }
+    return writer->flush();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    OwletAccountConfig account;
+    account.region = env_or("OWLET_REGION", "world");
+    account.user = std::string(env_or("OWLET_USER", "user@example.com"));
+    account.password = std::string(env_or("OWLET_PASSWORD", "password"));
+
+    LoadScenario scenario;
+    std::string path = kSyntheticTrace;
+    if (argc > 1) {
+        path = argv[1];
+        scenario.devices.assign(argv + 2, argv + argc);
+    } else {
+        scenario.devices = {"DSN0001", "DSN0002"};
+        OwletStatus recorded = record_synthetic(account, scenario);
+        if (!recorded) {
+            ESP_LOGE(TAG, "Recording failed: %s", recorded.error().what());
+            return 1;
+        }
+    }
+
+    OwletResult<std::vector<HttpExchange>> trace = load_http_trace(path);
+    if (!trace) {
+        ESP_LOGE(TAG, "Cannot load %s: %s", path.c_str(), trace.error().what());
+        return 1;
+    }
+    std::printf("trace %s: %u exchanges\n", path.c_str(), (unsigned)trace->size());
+    std::printf("%6s %8s %8s %7s %10s %8s %8s %8s %8s %7s\n", "speed", "threads", "ops", "errors",
+                "ops/s", "p50 us", "p90 us", "p99 us", "max us", "misses");
+
+    for (double speed : {1.0, 4.0, 0.0}) {
+        for (size_t threads : {1, 8}) {
+            // Paced runs are bounded by the recorded latency, so keep them short
+            LoadScenario run = scenario;
+            run.threads = threads;
+            run.iterations = speed == 0 ? 5000 : 20;
+
+            auto replay = std::make_shared<ReplayHttpClient>(*trace, speed);
+            LoadHarness harness([&] { return replay; }, account);
+            LoadReport report = harness.run(run);
+            std::printf("%6s %8u %8u %7u %10.0f %8lld %8lld %8lld %8lld %7u\n",
+                        speed == 0 ? "max" : (speed == 1.0 ? "1x" : "4x"), (unsigned)threads,
+                        (unsigned)report.operations, (unsigned)report.errors, report.operations_per_second,
+                        (long long)report.p50_us, (long long)report.p90_us, (long long)report.p99_us,
+                        (long long)report.max_us, (unsigned)replay->misses());
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,221 @@
+// Scales OwletManager from 1 to 50 accounts against an in-process mock of
+// the cloud and reports memory per account, poll throughput and jitter.
+//
+//   owlet_manager_bench [seconds] [latency_ms]
+//
+// Every account has two socks polled once a second through a
+// SingleFlightHttpClient over an 8-connection PooledHttpClient, drained by
+// 8 workers. The mock answers every GET after `latency_ms` (default 20).
+// A last run registers one login four times, the only case in which
+// single-flight merges requests, since headers are part of its key and
+// each account's requests are serialised.
+#include "owlet_manager.h"
+#include "pooled_http_client.h"
+#include "single_flight_http_client.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Count heap use so the per-account footprint can be reported
+static std::atomic<size_t> g_allocated{0};
+
+void* operator new(size_t size) {
+    g_allocated += size;
+    void* p = std::malloc(size ? size : 1);
+    if (!p) {
+        std::abort();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr uint32_t kIntervalMs = 1000;
+constexpr size_t kConnections = 8;
+constexpr size_t kWorkers = 8;
+
+class MockCloud : public HttpClient {
+public:
+    explicit MockCloud(int latency_ms) : latency_ms_(latency_ms), hits_(0) {}
+
+    OwletResult<std::string> post(const std::string& url, const std::string& data,
+                                  const std::map<std::string, std::string>& headers) override {
+        (void)data;
+        return get(url, headers);
+    }
+
+    OwletResult<std::string> get(const std::string& url,
+                                 const std::map<std::string, std::string>& headers) override {
+        (void)url;
+        (void)headers;
+        ++hits_;
+        std::this_thread::sleep_for(std::chrono::milliseconds(latency_ms_));
+        return std::string("{\"properties\":[]}");
+    }
+
+    size_t hits() const { return hits_; }
+
+private:
+    int latency_ms_;
+    std::atomic<size_t> hits_;
+};
+
+// Tracks the gap between consecutive polls of each sock
+class PollClock {
+public:
+    void record(const std::string& device) {
+        Clock::time_point now = Clock::now();
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto last = last_.find(device);
+        if (last != last_.end()) {
+            double gap_ms = std::chrono::duration<double, std::milli>(now - last->second).count();
+            lateness_ms_.push_back(gap_ms - kIntervalMs);
+            last->second = now;
+        } else {
+            last_.emplace(device, now);
+        }
+    }
+
+    // Steady-state polls per second across `socks`, from the mean gap
+    double rate(size_t socks) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (lateness_ms_.empty()) {
+            return 0;
+        }
+        double total = 0;
+        for (double late : lateness_ms_) {
+            total += late;
+        }
+        return socks * 1000.0 / (kIntervalMs + total / lateness_ms_.size());
+    }
+
+    double lateness(double p) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (lateness_ms_.empty()) {
+            return 0;
+        }
+        std::sort(lateness_ms_.begin(), lateness_ms_.end());
+        return lateness_ms_[(size_t)(p * (lateness_ms_.size() - 1))];
+    }
+
+private:
+    std::mutex mutex_;
+    std::map<std::string, Clock::time_point> last_;
+    std::vector<double> lateness_ms_;
+};
+
+struct Rig {
+    std::shared_ptr<MockCloud> cloud;
+    std::shared_ptr<PooledHttpClient> pool;
+    std::shared_ptr<SingleFlightHttpClient> single_flight;
+};
+
+Rig make_rig(int latency_ms) {
+    Rig rig;
+    rig.cloud = std::make_shared<MockCloud>(latency_ms);
+    std::shared_ptr<MockCloud> cloud = rig.cloud;
+    // Every pooled "connection" is the same mock; the pool counts them
+    rig.pool = std::make_shared<PooledHttpClient>([cloud] { return std::shared_ptr<HttpClient>(cloud); },
+                                                  kConnections);
+    rig.single_flight = std::make_shared<SingleFlightHttpClient>(rig.pool);
+    return rig;
+}
+
+OwletAccountConfig token_account(const std::string& token) {
+    OwletAccountConfig config;
+    config.region = "world";
+    config.token = token;
+    config.expiry = 1e12;
+    return config;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int seconds = argc > 1 ? std::atoi(argv[1]) : 5;
+    int latency_ms = argc > 2 ? std::atoi(argv[2]) : 20;
+
+    std::printf("%u s per run, %d ms mock latency, %u connections, %u workers, 2 socks per account every %u ms\n",
+                (unsigned)seconds, latency_ms, (unsigned)kConnections, (unsigned)kWorkers, (unsigned)kIntervalMs);
+    std::printf("%8s %14s %8s %8s %12s %11s %11s %12s\n", "accounts", "bytes/account", "polls/s", "target",
+                "upstream/s", "late p50 ms", "late p99 ms", "connections");
+
+    for (size_t accounts : {1, 5, 10, 25, 50}) {
+        Rig rig = make_rig(latency_ms);
+        OwletManager manager(rig.single_flight);
+        PollClock clock;
+        manager.set_properties_callback([&](size_t, const std::string& device,
+                                            const OwletResult<PropertiesResponse>& properties) {
+            if (properties) {
+                clock.record(device);
+            }
+        });
+
+        size_t before = g_allocated;
+        for (size_t i = 0; i < accounts; ++i) {
+            size_t id = manager.add_account(token_account("token-" + std::to_string(i)));
+            for (const char* sock : {"A", "B"}) {
+                OwletStatus added = manager.add_device(id, "DSN" + std::to_string(i) + sock, kIntervalMs);
+                if (!added) {
+                    std::fprintf(stderr, "add_device failed: %s\n", added.error().what());
+                    return 1;
+                }
+            }
+        }
+        size_t per_account = (g_allocated - before) / accounts;
+
+        OwletStatus started = manager.start(kWorkers);
+        if (!started) {
+            std::fprintf(stderr, "start failed: %s\n", started.error().what());
+            return 1;
+        }
+        std::this_thread::sleep_for(std::chrono::seconds(seconds));
+        manager.stop();
+
+        size_t socks = 2 * accounts;
+        std::printf("%8u %14u %8.1f %8u %12.1f %11.2f %11.2f %12u\n", (unsigned)accounts, (unsigned)per_account,
+                    clock.rate(socks), (unsigned)socks,
+                    (double)rig.cloud->hits() / seconds, clock.lateness(0.50), clock.lateness(0.99),
+                    (unsigned)rig.pool->created());
+    }
+
+    // One login registered four times: identical URL and headers, so
+    // concurrent polls share one upstream request
+    Rig rig = make_rig(latency_ms);
+    OwletManager manager(rig.single_flight);
+    std::atomic<size_t> polls{0};
+    manager.set_properties_callback([&](size_t, const std::string&, const OwletResult<PropertiesResponse>& properties) {
+        if (properties) {
+            ++polls;
+        }
+    });
+    for (int i = 0; i < 4; ++i) {
+        OwletStatus added = manager.add_device(manager.add_account(token_account("shared")), "DSN", kIntervalMs);
+        (void)added;
+    }
+    OwletStatus started = manager.start(kWorkers);
+    (void)started;
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    manager.stop();
+    std::printf("same login x4: %u polls, %u upstream requests, %u coalesced\n", (unsigned)polls,
+                (unsigned)rig.cloud->hits(), (unsigned)rig.single_flight->coalesced());
+    return 0;
+}
@@ -0,0 +1,69 @@
+// Records a trace of real Owlet cloud traffic for owlet_load_test.
+//
+//   owlet_record trace [device...]
+//
+// Signs in with OWLET_REGION (default "world"), OWLET_USER and
+// OWLET_PASSWORD, then runs authenticate, get_devices and get_properties
+// for each device OWLET_ITERATIONS times (default 1) through a
+// RecordingHttpClient over libcurl. Passwords and tokens are masked in the
+// trace, but it still holds account data; keep it private.
+#include "curl_http_client.h"
+#include "recording_http_client.h"
+#include "load_harness.h"
+#include "esp_log.h"
+#include <cstdio>
+#include <cstdlib>
+
+static const char* TAG = "OWLET_RECORD";
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s trace [device...]\n", argv[0]);
+        return 2;
+    }
+    const char* region = std::getenv("OWLET_REGION");
+    const char* user = std::getenv("OWLET_USER");
+    const char* password = std::getenv("OWLET_PASSWORD");
+    const char* iterations = std::getenv("OWLET_ITERATIONS");
+    if (!user || !password) {
+        ESP_LOGE(TAG, "Set OWLET_USER and OWLET_PASSWORD");
+        return 2;
+    }
+
+    OwletAccountConfig account;
+    account.region = region ? region : "world";
+    account.user = std::string(user);
+    account.password = std::string(password);
+
+    LoadScenario scenario;
+    scenario.threads = 1;
+    scenario.iterations = iterations ? std::strtoul(iterations, nullptr, 10) : 1;
+    scenario.devices.assign(argv + 2, argv + argc);
+
+    if (curl_global_init(CURL_GLOBAL_DEFAULT) != CURLE_OK) {
+        ESP_LOGE(TAG, "Failed to initialize libcurl");
+        return 1;
+    }
+
+    int rc = 0;
+    {
+        auto writer = std::make_shared<HttpTraceWriter>(argv[1]);
+        if (!writer->is_open()) {
+            curl_global_cleanup();
+            return 1;
+        }
+        auto recorder = std::make_shared<RecordingHttpClient>(std::make_shared<CurlHttpClient>(), writer);
+        LoadHarness harness([&] { return recorder; }, account);
+        LoadReport report = harness.run(scenario);
+
+        OwletStatus flushed = writer->flush();
+        if (!flushed) {
+            ESP_LOGE(TAG, "Failed to write %s: %s", argv[1], flushed.error().what());
+            rc = 1;
+        }
+        std::printf("recorded %u requests (%u failed) to %s\n", (unsigned)report.operations,
+                    (unsigned)report.errors, argv[1]);
+    }
+    curl_global_cleanup();
+    return rc;
+}
@@ -0,0 +1,74 @@
+#include "recording_http_client.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <utility>
+
+static const char* TAG = "RECORDING_HTTP_CLIENT";
+
+RecordingHttpClient::RecordingHttpClient(std::shared_ptr<HttpClient> inner, std::shared_ptr<HttpTraceWriter> writer)
+    : inner_(std::move(inner)), writer_(std::move(writer)), trace_start_us_(esp_timer_get_time()) {
+    inner_->set_chunk_callback([this](const char* data, size_t len) {
+        current_.chunks.push_back(HttpChunk{esp_timer_get_time() - trace_start_us_ - current_.start_us,
+                                            (uint32_t)len});
+        if (chunk_callback_) {
+            chunk_callback_(data, len);
+        }
+    });
+    ESP_LOGI(TAG, "Recording HTTP Client initialized");
+}
+
+RecordingHttpClient::~RecordingHttpClient() {
+    inner_->set_chunk_callback(nullptr);
+    ESP_LOGI(TAG, "Recording HTTP Client destroyed");
+}
+
+void RecordingHttpClient::set_chunk_callback(ChunkCallback callback) {
+    chunk_callback_ = std::move(callback);
+}
+
+OwletResult<std::string> RecordingHttpClient::post(const std::string& url, const std::string& data, 
+                                                   const std::map<std::string, std::string>& headers) {
+    return record(HttpMethod::Post, url, data, headers);
+}
+
+OwletResult<std::string> RecordingHttpClient::get(const std::string& url, 
+                                                  const std::map<std::string, std::string>& headers) {
+    return record(HttpMethod::Get, url, std::string(), headers);
+}
+
+OwletResult<std::string> RecordingHttpClient::record(HttpMethod method, const std::string& url, const std::string& data,
+                                                     const std::map<std::string, std::string>& headers) {
+    current_.method = method;
+    current_.url = url;
+    current_.body_hash = http_body_hash(data);
+    current_.chunks.clear();
+    current_.start_us = esp_timer_get_time() - trace_start_us_;
+
+    OwletResult<std::string> response = method == HttpMethod::Get ? inner_->get(url, headers)
+                                                                   : inner_->post(url, data, headers);
+
+    current_.duration_us = esp_timer_get_time() - trace_start_us_ - current_.start_us;
+    current_.result = response ? OwletErrc::Ok : response.code();
+    current_.detail = response ? 0 : response.error().detail;
+    current_.response = response ? *response : std::string();
+
+    // Chunks must add up to the stored body; clients that do not report
+    // chunks (or failed requests) are stored as one piece at the end
+    size_t chunked = 0;
+    for (const HttpChunk& chunk : current_.chunks) {
+        chunked += chunk.length;
+    }
+    if (chunked != current_.response.size()) {
+        current_.chunks.clear();
+        if (!current_.response.empty()) {
+            current_.chunks.push_back(HttpChunk{current_.duration_us, (uint32_t)current_.response.size()});
+        }
+    }
+
+    http_redact_secrets(current_.response);
+    OwletStatus status = writer_->append(current_);
+    if (!status) {
+        ESP_LOGW(TAG, "Failed to record %s: %s", url.c_str(), status.error().what());
+    }
+    return response;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "http_client.h"
+#include "http_trace.h"
+#include <string>
+#include <map>
+#include <memory>
+
+// Decorator that forwards requests to `inner` and appends every exchange,
+// with its timing and response chunk boundaries, to a trace. Handles one
+// request at a time, like the clients it wraps; to record a pool, wrap each
+// pooled client and share the writer. owlet_record wraps CurlHttpClient
+// with it to capture real cloud traffic.
+class RecordingHttpClient : public HttpClient {
+public:
+    RecordingHttpClient(std::shared_ptr<HttpClient> inner, std::shared_ptr<HttpTraceWriter> writer);
+    ~RecordingHttpClient() override;
+
+    OwletResult<std::string> post(const std::string& url, const std::string& data, 
+                                  const std::map<std::string, std::string>& headers) override;
+    OwletResult<std::string> get(const std::string& url, 
+                                 const std::map<std::string, std::string>& headers) override;
+    void set_chunk_callback(ChunkCallback callback) override;
+
+private:
+    OwletResult<std::string> record(HttpMethod method, const std::string& url, const std::string& data,
+                                    const std::map<std::string, std::string>& headers);
+
+    std::shared_ptr<HttpClient> inner_;
+    std::shared_ptr<HttpTraceWriter> writer_;
+    ChunkCallback chunk_callback_;
+    HttpExchange current_;
+    int64_t trace_start_us_;
+};
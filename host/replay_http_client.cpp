@@ -0,0 +1,100 @@
+#include "replay_http_client.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <chrono>
+#include <thread>
+#include <utility>
+
+static const char* TAG = "REPLAY_HTTP_CLIENT";
+
+ReplayHttpClient::ReplayHttpClient(std::vector<HttpExchange> exchanges, double speed)
+    : exchanges_(std::move(exchanges)), speed_(speed > 0 ? speed : 0), served_(0), misses_(0) {
+    for (size_t i = 0; i < exchanges_.size(); ++i) {
+        const HttpExchange& exchange = exchanges_[i];
+        index_[key(exchange.method, exchange.url, exchange.body_hash)].exchanges.push_back(i);
+    }
+    ESP_LOGI(TAG, "Replay HTTP Client initialized with %u exchanges (%u distinct requests)",
+             (unsigned)exchanges_.size(), (unsigned)index_.size());
+}
+
+ReplayHttpClient::~ReplayHttpClient() {
+    ESP_LOGI(TAG, "Replay HTTP Client destroyed");
+}
+
+std::string ReplayHttpClient::key(HttpMethod method, const std::string& url, uint64_t body_hash) {
+    std::string key(1, (char)method);
+    key += url;
+    for (int i = 0; i < 8; ++i) {
+        key.push_back((char)(body_hash >> (8 * i)));
+    }
+    return key;
+}
+
+void ReplayHttpClient::set_chunk_callback(ChunkCallback callback) {
+    chunk_callback_ = std::move(callback);
+}
+
+OwletResult<std::string> ReplayHttpClient::post(const std::string& url, const std::string& data, 
+                                                const std::map<std::string, std::string>& headers) {
+    (void)headers;
+    return serve(HttpMethod::Post, url, http_body_hash(data));
+}
+
+OwletResult<std::string> ReplayHttpClient::get(const std::string& url, 
+                                               const std::map<std::string, std::string>& headers) {
+    (void)headers;
+    return serve(HttpMethod::Get, url, http_body_hash(std::string()));
+}
+
+void ReplayHttpClient::wait_until(int64_t start_us, int64_t offset_us) const {
+    if (speed_ == 0) {
+        return;
+    }
+    int64_t remaining = start_us + (int64_t)(offset_us / speed_) - esp_timer_get_time();
+    if (remaining > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(remaining));
+    }
+}
+
+OwletResult<std::string> ReplayHttpClient::serve(HttpMethod method, const std::string& url, uint64_t body_hash) {
+    int64_t start_us = esp_timer_get_time();
+    const HttpExchange* exchange;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto entry = index_.find(key(method, url, body_hash));
+        if (entry == index_.end()) {
+            ++misses_;
+            ESP_LOGW(TAG, "No recorded exchange for %s", url.c_str());
+            return owlet_error(OwletErrc::InvalidResponse, "No recorded exchange for request");
+        }
+        Entry& recorded = entry->second;
+        exchange = &exchanges_[recorded.exchanges[recorded.next]];
+        recorded.next = (recorded.next + 1) % recorded.exchanges.size();
+        ++served_;
+    }
+
+    size_t position = 0;
+    for (const HttpChunk& chunk : exchange->chunks) {
+        wait_until(start_us, chunk.offset_us);
+        if (chunk_callback_) {
+            chunk_callback_(exchange->response.data() + position, chunk.length);
+        }
+        position += chunk.length;
+    }
+    wait_until(start_us, exchange->duration_us);
+
+    if (exchange->result != OwletErrc::Ok) {
+        return owlet_error(exchange->result, "Recorded request failed", exchange->detail);
+    }
+    return exchange->response;
+}
+
+size_t ReplayHttpClient::served() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return served_;
+}
+
+size_t ReplayHttpClient::misses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
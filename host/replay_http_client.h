@@ -0,0 +1,48 @@
+#pragma once
+
+#include "http_client.h"
+#include "http_trace.h"
+#include <string>
+#include <map>
+#include <vector>
+#include <mutex>
+
+// Serves responses from a recorded trace instead of the network. Requests
+// are matched on method, URL and request body hash; repeated requests walk
+// through the recorded responses for that key in order and wrap around, so
+// a short trace can drive an arbitrarily long run deterministically.
+//
+// `speed` scales recorded timing: 1.0 reproduces the original latency and
+// chunk arrival times, 2.0 runs twice as fast, and 0 returns immediately.
+class ReplayHttpClient : public HttpClient {
+public:
+    explicit ReplayHttpClient(std::vector<HttpExchange> exchanges, double speed = 1.0);
+    ~ReplayHttpClient() override;
+
+    OwletResult<std::string> post(const std::string& url, const std::string& data, 
+                                  const std::map<std::string, std::string>& headers) override;
+    OwletResult<std::string> get(const std::string& url, 
+                                 const std::map<std::string, std::string>& headers) override;
+    void set_chunk_callback(ChunkCallback callback) override;
+
+    size_t served() const;
+    size_t misses() const;
+
+private:
+    struct Entry {
+        std::vector<size_t> exchanges;
+        size_t next;
+    };
+
+    static std::string key(HttpMethod method, const std::string& url, uint64_t body_hash);
+    OwletResult<std::string> serve(HttpMethod method, const std::string& url, uint64_t body_hash);
+    void wait_until(int64_t start_us, int64_t offset_us) const;
+
+    std::vector<HttpExchange> exchanges_;
+    std::map<std::string, Entry> index_;
+    double speed_;
+    ChunkCallback chunk_callback_;
+    size_t served_;
+    size_t misses_;
+    mutable std::mutex mutex_;
+};
@@ -0,0 +1,159 @@
+// Measures VitalsStore ingest rate and compression on a sock-like signal:
+// heart rate and oxygen level sampled once a second with occasional gaps.
+//
+//   owlet_vitals_bench [samples] [cold_file]
+//
+// Prints ingest throughput, bytes of storage per sample, range query and
+// downsample cost, then reopens the cold file and checks that every
+// sample is recovered. The cold file (default owlet_vitals_bench.bin) is
+// removed afterwards.
+#include "vitals_store.h"
+#include "file_block_storage.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kHotBlocks = 64;
+constexpr size_t kColdBlocks = 4096;
+
+struct Signal {
+    std::vector<uint32_t> timestamps;
+    std::vector<float> heart_rate;
+    std::vector<float> oxygen;
+};
+
+// Deterministic random walk; one reading in fifty arrives a second late
+Signal make_signal(size_t samples) {
+    Signal signal;
+    std::mt19937 rng(1);
+    uint32_t ts = 1700000000;
+    float heart_rate = 120;
+    float oxygen = 98;
+    for (size_t i = 0; i < samples; ++i) {
+        ts += rng() % 50 == 0 ? 2 : 1;
+        if (rng() % 4 == 0) {
+            heart_rate += (int)(rng() % 3) - 1;
+        }
+        if (rng() % 20 == 0) {
+            oxygen += (int)(rng() % 3) - 1;
+        }
+        if (oxygen > 100) {
+            oxygen = 100;
+        }
+        signal.timestamps.push_back(ts);
+        signal.heart_rate.push_back(heart_rate);
+        signal.oxygen.push_back(oxygen);
+    }
+    return signal;
+}
+
+double us_between(Clock::time_point a, Clock::time_point b) {
+    return std::chrono::duration<double, std::micro>(b - a).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t samples = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    std::string path = argc > 2 ? argv[2] : "owlet_vitals_bench.bin";
+    if (samples < 1000) {
+        std::fprintf(stderr, "need at least 1000 samples\n");
+        return 2;
+    }
+    Signal signal = make_signal(samples);
+    std::remove(path.c_str());
+
+    int rc = 0;
+    {
+        VitalsStore store(kHotBlocks, std::make_shared<FileBlockStorage>(path, kVitalsBlockSize, kColdBlocks));
+        uint8_t heart_rate = *store.add_series("HEART_RATE");
+        uint8_t oxygen = *store.add_series("OXYGEN_LEVEL");
+
+        Clock::time_point start = Clock::now();
+        for (size_t i = 0; i < samples; ++i) {
+            OwletStatus a = store.append(heart_rate, signal.timestamps[i], signal.heart_rate[i]);
+            OwletStatus b = store.append(oxygen, signal.timestamps[i], signal.oxygen[i]);
+            if (!a || !b) {
+                std::fprintf(stderr, "append failed at %u\n", (unsigned)i);
+                return 1;
+            }
+        }
+        double ingest_us = us_between(start, Clock::now());
+
+        VitalsStoreStats stats = store.stats();
+        size_t blocks = stats.open_blocks + stats.hot_blocks + stats.cold_blocks;
+        std::printf("%u samples in %u blocks (%u hot, %u cold)\n", (unsigned)stats.samples, (unsigned)blocks,
+                    (unsigned)stats.hot_blocks, (unsigned)stats.cold_blocks);
+        std::printf("ingest %.1f M samples/s\n", stats.samples / ingest_us);
+        std::printf("%.3f bytes/sample stored, %.2f payload bits/sample\n",
+                    (double)blocks * kVitalsBlockSize / stats.samples, (double)stats.payload_bits / stats.samples);
+
+        // Everything written must read back bit-exact
+        size_t visited = 0;
+        bool exact = true;
+        OwletStatus queried = store.query(heart_rate, 0, UINT32_MAX, [&](const VitalsSample& sample) {
+            if (visited >= samples || sample.timestamp != signal.timestamps[visited] ||
+                sample.value != signal.heart_rate[visited]) {
+                exact = false;
+            }
+            ++visited;
+        });
+        std::printf("full query: %u samples, %s\n", (unsigned)visited,
+                    queried && exact && visited == samples ? "exact" : "MISMATCH");
+        if (!queried || !exact || visited != samples) {
+            rc = 1;
+        }
+
+        // Ten minutes from the middle of the history
+        uint32_t from = signal.timestamps[samples / 2];
+        uint32_t to = signal.timestamps[samples / 2 + 600];
+        size_t in_range = 0;
+        start = Clock::now();
+        for (int r = 0; r < 100; ++r) {
+            in_range = 0;
+            OwletStatus status = store.query(heart_rate, from, to, [&](const VitalsSample&) { ++in_range; });
+            (void)status;
+        }
+        std::printf("range query: %u samples in %.1f us\n", (unsigned)in_range, us_between(start, Clock::now()) / 100);
+
+        std::vector<VitalsBucket> buckets;
+        start = Clock::now();
+        for (int r = 0; r < 10; ++r) {
+            OwletStatus status =
+                store.downsample(heart_rate, signal.timestamps.front(), signal.timestamps.back(), 3600, buckets);
+            (void)status;
+        }
+        std::printf("hourly downsample of the full history: %u buckets in %.1f us\n", (unsigned)buckets.size(),
+                    us_between(start, Clock::now()) / 10);
+
+        OwletStatus flushed = store.flush();
+        if (!flushed) {
+            std::fprintf(stderr, "flush failed: %s\n", flushed.error().what());
+            rc = 1;
+        }
+    }
+
+    // Reopen the cold file as after a reboot
+    {
+        Clock::time_point start = Clock::now();
+        VitalsStore store(kHotBlocks, std::make_shared<FileBlockStorage>(path, kVitalsBlockSize, kColdBlocks));
+        double recover_us = us_between(start, Clock::now());
+        uint8_t heart_rate = *store.add_series("HEART_RATE");
+        size_t recovered = 0;
+        OwletStatus queried = store.query(heart_rate, 0, UINT32_MAX, [&](const VitalsSample&) { ++recovered; });
+        std::printf("recovered %u heart rate samples in %.1f us\n", (unsigned)recovered, recover_us);
+        if (!queried || recovered != samples) {
+            rc = 1;
+        }
+    }
+    std::remove(path.c_str());
+    return rc;
+}
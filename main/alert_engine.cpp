@@ -0,0 +1,194 @@
+#include "alert_engine.h"
+#include "owlet_api.h"
+#include "esp_log.h"
+#include <utility>
+#include <cmath>
+
+static const char* TAG = "ALERT_ENGINE";
+
+static constexpr size_t kMaxRules = UINT16_MAX;
+
+AlertEngine::AlertEngine() {
+    signal_offsets_.push_back(0);
+}
+
+AlertEngine::~AlertEngine() {
+    ESP_LOGI(TAG, "Alert engine destroyed");
+}
+
+OwletStatus AlertEngine::compile(const std::vector<AlertRule>& rules) {
+    if (rules.size() > kMaxRules) {
+        return owlet_error(OwletErrc::CapacityExceeded, "Too many alert rules");
+    }
+
+    std::vector<std::string> signals;
+    std::vector<uint16_t> rule_signal;
+    std::vector<std::string> names;
+    std::vector<Step> plan;
+    rule_signal.reserve(rules.size());
+    names.reserve(rules.size());
+    plan.reserve(rules.size());
+
+    for (const AlertRule& rule : rules) {
+        if (rule.property.empty()) {
+            ESP_LOGE(TAG, "Rule %s has no property", rule.name.c_str());
+            return owlet_error(OwletErrc::InvalidArgument, "Alert rule has no property");
+        }
+
+        float clear = rule.clear.value_or(rule.trigger);
+        // A NaN level compares false against every sample, so the alert
+        // would never fire or would clear on the next sample
+        if (!std::isfinite(rule.trigger) || !std::isfinite(clear)) {
+            ESP_LOGE(TAG, "Rule %s has a non-finite trigger or clear level", rule.name.c_str());
+            return owlet_error(OwletErrc::InvalidArgument, "Alert levels must be finite");
+        }
+        bool above = rule.condition == AlertCondition::Above;
+        if (above ? clear > rule.trigger : clear < rule.trigger) {
+            ESP_LOGE(TAG, "Rule %s clears on the wrong side of its trigger", rule.name.c_str());
+            return owlet_error(OwletErrc::InvalidArgument, "Alert clear level is past its trigger");
+        }
+        if (rule.metric == AlertMetric::Rate && rule.rate_window_seconds == 0) {
+            ESP_LOGE(TAG, "Rule %s has an empty rate window", rule.name.c_str());
+            return owlet_error(OwletErrc::InvalidArgument, "Alert rate window must be non-zero");
+        }
+
+        size_t signal = 0;
+        while (signal < signals.size() && signals[signal] != rule.property) {
+            ++signal;
+        }
+        if (signal == signals.size()) {
+            signals.push_back(rule.property);
+        }
+
+        rule_signal.push_back((uint16_t)signal);
+        names.push_back(rule.name);
+        plan.push_back(Step{rule.metric, rule.condition, rule.trigger, clear,
+                            rule.sustain_seconds, rule.rate_window_seconds});
+    }
+
+    // Group rule indices by signal so a sample only touches its own rules
+    std::vector<uint16_t> offsets(signals.size() + 1, 0);
+    for (uint16_t signal : rule_signal) {
+        ++offsets[signal + 1];
+    }
+    for (size_t i = 1; i < offsets.size(); ++i) {
+        offsets[i] += offsets[i - 1];
+    }
+    std::vector<uint16_t> index(rules.size());
+    std::vector<uint16_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t rule = 0; rule < rule_signal.size(); ++rule) {
+        index[fill[rule_signal[rule]]++] = (uint16_t)rule;
+    }
+
+    signals_ = std::move(signals);
+    signal_offsets_ = std::move(offsets);
+    rule_index_ = std::move(index);
+    names_ = std::move(names);
+    plan_ = std::move(plan);
+    state_.assign(plan_.size(), State{});
+
+    ESP_LOGI(TAG, "Compiled %u alert rules over %u properties",
+             (unsigned)plan_.size(), (unsigned)signals_.size());
+    return {};
+}
+
+void AlertEngine::set_callback(Callback callback) {
+    callback_ = std::move(callback);
+}
+
+void AlertEngine::reset() {
+    state_.assign(plan_.size(), State{});
+}
+
+OwletResult<uint16_t> AlertEngine::signal_id(const std::string& property) const {
+    for (size_t i = 0; i < signals_.size(); ++i) {
+        if (signals_[i] == property) {
+            return (uint16_t)i;
+        }
+    }
+    return owlet_error(OwletErrc::InvalidArgument, "No alert rule watches this property");
+}
+
+OwletStatus AlertEngine::on_sample(uint16_t signal, uint32_t timestamp, float value) {
+    if (signal >= signals_.size()) {
+        return owlet_error(OwletErrc::InvalidArgument, "Unknown alert signal");
+    }
+    if (!std::isfinite(value)) {
+        return owlet_error(OwletErrc::InvalidArgument, "Alert sample is not finite");
+    }
+    for (uint16_t i = signal_offsets_[signal]; i < signal_offsets_[signal + 1]; ++i) {
+        evaluate(rule_index_[i], timestamp, value);
+    }
+    return {};
+}
+
+void AlertEngine::evaluate(uint16_t rule, uint32_t timestamp, float value) {
+    const Step& step = plan_[rule];
+    State& state = state_[rule];
+
+    float metric = value;
+    if (step.metric == AlertMetric::Rate) {
+        // Rate is measured once per elapsed window against the previous anchor
+        if (!state.has_anchor || timestamp < state.anchor_ts) {
+            state.has_anchor = true;
+            state.anchor_ts = timestamp;
+            state.anchor_value = value;
+            return;
+        }
+        uint32_t elapsed = timestamp - state.anchor_ts;
+        if (elapsed < step.rate_window_seconds) {
+            return;
+        }
+        state.rate = (value - state.anchor_value) / (float)elapsed;
+        state.anchor_ts = timestamp;
+        state.anchor_value = value;
+        metric = state.rate;
+    }
+    // An overflowing rate must not clear or raise anything
+    if (!std::isfinite(metric)) {
+        return;
+    }
+
+    bool above = step.condition == AlertCondition::Above;
+    if (state.active) {
+        bool holding = above ? metric > step.clear : metric < step.clear;
+        if (!holding) {
+            state.active = false;
+            state.breaching = false;
+            if (callback_) {
+                callback_(AlertEvent{AlertEventType::Cleared, rule, names_[rule].c_str(), timestamp, metric});
+            }
+        }
+        return;
+    }
+
+    bool breach = above ? metric > step.trigger : metric < step.trigger;
+    if (!breach) {
+        state.breaching = false;
+        return;
+    }
+    if (!state.breaching || timestamp < state.breach_since) {
+        state.breaching = true;
+        state.breach_since = timestamp;
+    }
+    if (timestamp - state.breach_since >= step.sustain_seconds) {
+        state.active = true;
+        if (callback_) {
+            callback_(AlertEvent{AlertEventType::Raised, rule, names_[rule].c_str(), timestamp, metric});
+        }
+    }
+}
+
+size_t AlertEngine::ingest(const PropertiesResponse& properties, uint32_t timestamp) {
+    size_t evaluated = 0;
+    for (size_t signal = 0; signal < signals_.size(); ++signal) {
+        OwletResult<float> value = property_value(properties, signals_[signal]);
+        if (!value) {
+            continue;
+        }
+        if (on_sample((uint16_t)signal, timestamp, *value)) {
+            ++evaluated;
+        }
+    }
+    return evaluated;
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <optional>
+#include <functional>
+#include "owlet_result.h"
+
+struct PropertiesResponse;
+
+enum class AlertMetric : uint8_t {
+    Value,      // the sample itself
+    Rate,       // change per second, measured over `rate_window_seconds`
+};
+
+enum class AlertCondition : uint8_t {
+    Above,
+    Below,
+};
+
+// Rule description. Rules are compiled once by AlertEngine::compile; the
+// strings here are not consulted again while evaluating samples.
+struct AlertRule {
+    std::string name;
+    std::string property;
+    AlertMetric metric = AlertMetric::Value;
+    AlertCondition condition = AlertCondition::Above;
+    float trigger = 0.0f;
+    // Level that clears an active alert (hysteresis); defaults to `trigger`
+    std::optional<float> clear;
+    // Breach must hold continuously this long before the alert is raised
+    uint32_t sustain_seconds = 0;
+    uint32_t rate_window_seconds = 1;
+};
+
+enum class AlertEventType : uint8_t {
+    Raised,
+    Cleared,
+};
+
+struct AlertEvent {
+    AlertEventType type;
+    uint16_t rule;
+    const char* name;       // owned by the engine, valid until the next compile
+    uint32_t timestamp;
+    float value;            // metric that caused the transition
+};
+
+// Incremental alert rule engine.
+//
+// compile() turns the rules into a flat evaluation plan: rules are grouped
+// by property, and each rule gets a fixed-size state slot. on_sample() then
+// updates only the rules watching that property, in constant time per rule
+// and without allocating.
+class AlertEngine {
+public:
+    using Callback = std::function<void(const AlertEvent&)>;
+
+    AlertEngine();
+    ~AlertEngine();
+
+    OwletStatus compile(const std::vector<AlertRule>& rules);
+    void set_callback(Callback callback);
+
+    // Resolve a property name to the signal id used by on_sample()
+    OwletResult<uint16_t> signal_id(const std::string& property) const;
+    // Non-finite samples are rejected and leave every alert untouched
+    OwletStatus on_sample(uint16_t signal, uint32_t timestamp, float value);
+
+    // Feed every watched property present in `properties`. Returns the
+    // number of samples evaluated.
+    size_t ingest(const PropertiesResponse& properties, uint32_t timestamp);
+
+    // Drop all window and alert state, keeping the compiled plan
+    void reset();
+
+    size_t rule_count() const { return plan_.size(); }
+    bool is_active(uint16_t rule) const { return rule < state_.size() && state_[rule].active; }
+
+private:
+    // Compiled rule: everything on_sample() needs, with no strings
+    struct Step {
+        AlertMetric metric;
+        AlertCondition condition;
+        float trigger;
+        float clear;
+        uint32_t sustain_seconds;
+        uint32_t rate_window_seconds;
+    };
+
+    struct State {
+        bool active;
+        bool breaching;
+        bool has_anchor;
+        uint32_t breach_since;
+        uint32_t anchor_ts;
+        float anchor_value;
+        float rate;
+    };
+
+    void evaluate(uint16_t rule, uint32_t timestamp, float value);
+
+    std::vector<std::string> signals_;
+    std::vector<uint16_t> signal_offsets_;   // signals_.size() + 1 entries into rule_index_
+    std::vector<uint16_t> rule_index_;       // rules grouped by signal
+    std::vector<std::string> names_;
+    std::vector<Step> plan_;
+    std::vector<State> state_;
+    Callback callback_;
+};
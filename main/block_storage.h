@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "owlet_result.h"
+
+// Fixed-size block storage used as the cold tier of VitalsStore.
+// Slots are written sequentially as a ring; implementations that need an
+// erase before write (flash) do it when a write starts a new erase sector.
+class BlockStorage {
+public:
+    virtual ~BlockStorage() = default;
+    virtual size_t block_size() const = 0;
+    virtual size_t capacity() const = 0;
+    // Number of consecutive slots wiped when a write starts a new erase unit
+    virtual size_t erase_blocks() const { return 1; }
+    virtual OwletStatus write(size_t slot, const void* data, size_t len) = 0;
+    virtual OwletStatus read(size_t slot, size_t offset, void* out, size_t len) = 0;
+};
@@ -0,0 +1,56 @@
+#include "file_block_storage.h"
+#include "esp_log.h"
+
+static const char* TAG = "FILE_BLOCK_STORAGE";
+
+FileBlockStorage::FileBlockStorage(const std::string& path, size_t block_size, size_t capacity)
+    : file_(nullptr), block_size_(block_size), capacity_(capacity) {
+    // Reuse an existing file so previously spilled blocks survive restarts
+    file_ = std::fopen(path.c_str(), "r+b");
+    if (!file_) {
+        file_ = std::fopen(path.c_str(), "w+b");
+    }
+    if (!file_) {
+        ESP_LOGE(TAG, "Failed to open %s", path.c_str());
+        return;
+    }
+    ESP_LOGI(TAG, "Opened %s (%u blocks of %u bytes)", path.c_str(),
+             (unsigned)capacity_, (unsigned)block_size_);
+}
+
+FileBlockStorage::~FileBlockStorage() {
+    if (file_) {
+        std::fclose(file_);
+    }
+}
+
+OwletStatus FileBlockStorage::write(size_t slot, const void* data, size_t len) {
+    if (!file_) {
+        return owlet_error(OwletErrc::StorageFailed, "Block file not open");
+    }
+    if (slot >= capacity_ || len > block_size_) {
+        return owlet_error(OwletErrc::InvalidArgument, "Block write out of range");
+    }
+    if (std::fseek(file_, (long)(slot * block_size_), SEEK_SET) != 0 ||
+        std::fwrite(data, 1, len, file_) != len ||
+        std::fflush(file_) != 0) {
+        ESP_LOGE(TAG, "Failed to write block %u", (unsigned)slot);
+        return owlet_error(OwletErrc::StorageFailed, "Block file write failed");
+    }
+    return {};
+}
+
+OwletStatus FileBlockStorage::read(size_t slot, size_t offset, void* out, size_t len) {
+    if (!file_) {
+        return owlet_error(OwletErrc::StorageFailed, "Block file not open");
+    }
+    if (slot >= capacity_ || offset + len > block_size_) {
+        return owlet_error(OwletErrc::InvalidArgument, "Block read out of range");
+    }
+    // Slots past the end of the file have never been written
+    if (std::fseek(file_, (long)(slot * block_size_ + offset), SEEK_SET) != 0 ||
+        std::fread(out, 1, len, file_) != len) {
+        return owlet_error(OwletErrc::StorageFailed, "Block not present in file");
+    }
+    return {};
+}
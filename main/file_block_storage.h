@@ -0,0 +1,23 @@
+#pragma once
+
+#include "block_storage.h"
+#include <cstdio>
+#include <string>
+
+// File-backed block storage, used in place of a flash partition on host
+// builds (or on a mounted VFS filesystem on target).
+class FileBlockStorage : public BlockStorage {
+public:
+    FileBlockStorage(const std::string& path, size_t block_size, size_t capacity);
+    ~FileBlockStorage() override;
+
+    size_t block_size() const override { return block_size_; }
+    size_t capacity() const override { return file_ ? capacity_ : 0; }
+    OwletStatus write(size_t slot, const void* data, size_t len) override;
+    OwletStatus read(size_t slot, size_t offset, void* out, size_t len) override;
+
+private:
+    std::FILE* file_;
+    size_t block_size_;
+    size_t capacity_;
+};
@@ -1,12 +1,23 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <map>
+#include <functional>
+#include "owlet_result.h"
 
 // HTTP client interface (to be implemented with ESP-IDF HTTP client)
+// Implementations return the response body on success, or an OwletError
+// describing the transport failure or non-2xx status.
 class HttpClient {
 public:
+    using ChunkCallback = std::function<void(const char* data, size_t len)>;
+
     virtual ~HttpClient() = default;
-    virtual bool post(const std::string& url, const std::string& data, const std::map<std::string, std::string>& headers, std::string& response) = 0;
-    virtual bool get(const std::string& url, const std::map<std::string, std::string>& headers, std::string& response) = 0;
-}; 
\ No newline at end of file
+    virtual OwletResult<std::string> post(const std::string& url, const std::string& data, const std::map<std::string, std::string>& headers) = 0;
+    virtual OwletResult<std::string> get(const std::string& url, const std::map<std::string, std::string>& headers) = 0;
+
+    // Observe response body chunks as they arrive. Clients that only see
+    // whole bodies may ignore this.
+    virtual void set_chunk_callback(ChunkCallback callback) { (void)callback; }
+}; 
@@ -1,4 +1,3 @@
-#include <iostream>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_system.h"
@@ -25,9 +24,9 @@ extern "C" void app_main(void)
     
     // Authenticate with the API
     ESP_LOGI(TAG, "Attempting to authenticate...");
-    bool auth_success = api.authenticate();
+    OwletStatus auth_status = api.authenticate();
     
-    if (auth_success) {
+    if (auth_status) {
         ESP_LOGI(TAG, "Authentication successful!");
         
         // Get current tokens
@@ -40,12 +39,40 @@ extern "C" void app_main(void)
         }
         
         // You can now use other API methods like:
-        // DevicesResponse devices = api.get_devices();
-        // PropertiesResponse props = api.get_properties("device_serial");
-        // bool activated = api.activate("device_serial");
+        // OwletResult<DevicesResponse> devices = api.get_devices();
+        // OwletResult<PropertiesResponse> props = api.get_properties("device_serial");
+        // OwletStatus activated = api.activate("device_serial");
+        //
+        // To keep vitals history, feed property samples into a VitalsStore
+        // backed by the "vitals" flash partition. The history survives reboots,
+        // so timestamps are wall-clock seconds (start SNTP and wait for sync):
+        // VitalsStore history(16, std::make_shared<PartitionBlockStorage>("vitals", kVitalsBlockSize));
+        // history.add_series("HEART_RATE");
+        // history.add_series("OXYGEN_LEVEL");
+        // if (props) history.ingest(*props, (uint32_t)time(nullptr));
+        //
+        // Alarms are raised by an AlertEngine fed from the same samples:
+        // AlertEngine alerts;
+        // alerts.compile({
+        //     {"low_oxygen", "OXYGEN_LEVEL", AlertMetric::Value, AlertCondition::Below, 90.0f, 92.0f, 10},
+        //     {"high_heart_rate", "HEART_RATE", AlertMetric::Value, AlertCondition::Above, 220.0f, 210.0f, 10},
+        //     {"low_heart_rate", "HEART_RATE", AlertMetric::Value, AlertCondition::Below, 80.0f, 85.0f, 10},
+        //     {"sock_off", "SOCK_OFF", AlertMetric::Value, AlertCondition::Above, 0.5f},
+        // });
+        // alerts.set_callback([](const AlertEvent& event) { ESP_LOGW(TAG, "Alert: %s", event.name); });
+        // if (props) alerts.ingest(*props, esp_timer_get_time() / 1000000);
+        //
+        // Several accounts can share one pool of EspHttpClient connections
+        // (owlet_esp_http_client.h) through OwletManager:
+        // auto pool = std::make_shared<PooledHttpClient>([] { return std::make_shared<EspHttpClient>(); }, 4);
+        // OwletManager manager(std::make_shared<SingleFlightHttpClient>(pool));
+        // size_t account = manager.add_account({"world", "user@example.com", "password"});
+        // manager.add_device(account, "device_serial", 10000);
+        // manager.start(2);
         
     } else {
-        ESP_LOGE(TAG, "Authentication failed!");
+        ESP_LOGE(TAG, "Authentication failed: %s (%s)", auth_status.error().what(),
+                 owlet_errc_name(auth_status.code()));
     }
     
     // Keep the task alive
@@ -10,6 +10,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "http_client.h"
+#include "owlet_result.h"
 
 // Forward declarations
 struct TokenDict;
@@ -18,35 +19,6 @@ struct DevicesResponse;
 struct PropertiesResponse;
 class EspHttpClient;
 
-// Error handling without exceptions (ESP32 builds with -fno-exceptions)
-class OwletError {
-public:
-    explicit OwletError(const std::string& message) : message_(message) {}
-    const char* what() const noexcept { return message_.c_str(); }
-private:
-    std::string message_;
-};
-
-class OwletCredentialsError : public OwletError {
-public:
-    explicit OwletCredentialsError(const std::string& message) : OwletError(message) {}
-};
-
-class OwletAuthenticationError : public OwletError {
-public:
-    explicit OwletAuthenticationError(const std::string& message) : OwletError(message) {}
-};
-
-class OwletConnectionError : public OwletError {
-public:
-    explicit OwletConnectionError(const std::string& message) : OwletError(message) {}
-};
-
-class OwletDevicesError : public OwletError {
-public:
-    explicit OwletDevicesError(const std::string& message) : OwletError(message) {}
-};
-
 // Data structures
 struct TokenDict {
     std::optional<std::string> api_token;
@@ -77,6 +49,9 @@ struct PropertiesResponse {
     std::optional<TokenDict> tokens;
 };
 
+// Decode the numeric "value" field of `property` from a properties response
+OwletResult<float> property_value(const PropertiesResponse& properties, const std::string& property);
+
 // Main API class
 class OwletAPI {
 public:
@@ -93,14 +68,14 @@ public:
     ~OwletAPI();
 
     // Authentication methods
-    bool authenticate();
-    bool validate_authentication();
-    bool refresh_authentication();
+    OwletStatus authenticate();
+    OwletStatus validate_authentication();
+    OwletStatus refresh_authentication();
 
     // Device management
-    DevicesResponse get_devices(const std::vector<int>& versions = {3, 2});
-    bool activate(const std::string& device_serial);
-    PropertiesResponse get_properties(const std::string& device);
+    OwletResult<DevicesResponse> get_devices(const std::vector<int>& versions = {3, 2});
+    OwletStatus activate(const std::string& device_serial);
+    OwletResult<PropertiesResponse> get_properties(const std::string& device);
 
     // Token management
     TokenDict get_tokens() const;
@@ -108,18 +83,32 @@ public:
 
 private:
     // Private methods
-    bool password_verification();
-    std::string get_mini_token(const std::string& id_token);
-    std::optional<TokenDict> token_sign_in(const std::string& mini_token);
+    OwletStatus password_verification();
+    OwletResult<std::string> get_mini_token(const std::string& id_token);
+    OwletResult<TokenDict> token_sign_in(const std::string& mini_token);
     void update_tokens(const std::optional<std::string>& new_token, 
                       const std::optional<double>& new_expiry, 
                       const std::optional<std::string>& new_refresh);
     bool is_valid_version(const std::string& dsn, const std::vector<int>& versions);
-    std::optional<std::string> request(const std::string& method, const std::string& url, 
-                                      const std::optional<std::map<std::string, std::string>>& data = std::nullopt);
+    OwletResult<std::string> request(const std::string& method, const std::string& url, 
+                                     const std::optional<std::map<std::string, std::string>>& data = std::nullopt);
+
+    // Region information
+    struct RegionInfo {
+        const char* name;
+        const char* url_base;
+        const char* url_mini;
+        const char* url_signin;
+        const char* api_key;
+    };
+
+    // Region table is immutable, so instances never share mutable state
+    static const RegionInfo* find_region(const std::string& region);
 
     // Member variables
     std::string region_;
+    const RegionInfo* region_info_;
+    OwletStatus init_status_;
     std::optional<std::string> user_;
     std::optional<std::string> password_;
     std::optional<std::string> auth_token_;
@@ -129,15 +118,4 @@ private:
     std::shared_ptr<HttpClient> http_client_;
     std::map<std::string, std::string> headers_;
     std::string api_url_;
-
-    // Region information
-    struct RegionInfo {
-        std::string url_base;
-        std::string url_mini;
-        std::string url_signin;
-        std::string api_key;
-    };
-
-    static std::map<std::string, RegionInfo> region_info_;
-    static void initialize_region_info();
 }; 
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include "owlet_esp_http_client.h"
+#include "owlet_api.h"
+#include "esp_log.h"
+#include "esp_err.h"
+#include <cstring>
+#include <utility>
+
+static const char* TAG = "ESP_HTTP_CLIENT";
+
+EspHttpClient::EspHttpClient() : client_(nullptr) {
+    ESP_LOGI(TAG, "ESP HTTP Client initialized");
+}
+
+EspHttpClient::~EspHttpClient() {
+    close();
+    ESP_LOGI(TAG, "ESP HTTP Client destroyed");
+}
+
+void EspHttpClient::set_chunk_callback(ChunkCallback callback) {
+    chunk_callback_ = std::move(callback);
+}
+
+esp_err_t EspHttpClient::http_event_handler(esp_http_client_event_t *evt) {
+    EspHttpClient* self = static_cast<EspHttpClient*>(evt->user_data);
+    switch(evt->event_id) {
+        case HTTP_EVENT_ERROR:
+            ESP_LOGE(TAG, "HTTP Client Error");
+            break;
+        case HTTP_EVENT_ON_CONNECTED:
+            ESP_LOGI(TAG, "HTTP Client Connected");
+            break;
+        case HTTP_EVENT_HEADER_SENT:
+            ESP_LOGI(TAG, "HTTP Client Header Sent");
+            break;
+        case HTTP_EVENT_ON_HEADER:
+            ESP_LOGI(TAG, "HTTP Client Header Received");
+            break;
+        case HTTP_EVENT_ON_DATA:
+            ESP_LOGI(TAG, "HTTP Client Data Received, len=%d", evt->data_len);
+            if (evt->data) {
+                self->response_data_.append((char*)evt->data, evt->data_len);
+                if (self->chunk_callback_) {
+                    self->chunk_callback_((const char*)evt->data, evt->data_len);
+                }
+            }
+            break;
+        case HTTP_EVENT_ON_FINISH:
+            ESP_LOGI(TAG, "HTTP Client Finished");
+            break;
+        case HTTP_EVENT_DISCONNECTED:
+            ESP_LOGI(TAG, "HTTP Client Disconnected");
+            break;
+        default:
+            break;
+    }
+    return ESP_OK;
+}
+
+std::string EspHttpClient::url_origin(const std::string& url) {
+    size_t scheme = url.find("://");
+    size_t start = scheme == std::string::npos ? 0 : scheme + 3;
+    return url.substr(0, url.find('/', start));
+}
+
+void EspHttpClient::close() {
+    if (client_) {
+        esp_http_client_cleanup(client_);
+        client_ = nullptr;
+    }
+    origin_.clear();
+    header_names_.clear();
+}
+
+OwletStatus EspHttpClient::connect(const std::string& url, bool& reused) {
+    std::string origin = url_origin(url);
+    reused = client_ && origin == origin_;
+    if (reused) {
+        esp_err_t err = esp_http_client_set_url(client_, url.c_str());
+        if (err == ESP_OK) {
+            return {};
+        }
+        ESP_LOGW(TAG, "Failed to reuse connection: %s", esp_err_to_name(err));
+        reused = false;
+    }
+
+    // A different origin needs its own transport, so start a fresh handle
+    close();
+    esp_http_client_config_t config = {};
+    config.url = url.c_str();
+    config.event_handler = http_event_handler;
+    config.user_data = this;
+    config.keep_alive_enable = true;
+
+    client_ = esp_http_client_init(&config);
+    if (!client_) {
+        ESP_LOGE(TAG, "Failed to initialize HTTP client");
+        return owlet_error(OwletErrc::ClientInitFailed, "Failed to initialize HTTP client");
+    }
+    origin_ = std::move(origin);
+    return {};
+}
+
+OwletResult<std::string> EspHttpClient::perform(esp_http_client_method_t method, const char* name,
+                                                const std::string& url, const std::string& data,
+                                                const std::map<std::string, std::string>& headers) {
+    // A kept-alive connection may have been dropped by the server while
+    // idle; GETs are safe to retry once on a fresh one
+    for (int attempt = 0; ; ++attempt) {
+        bool reused = false;
+        OwletStatus connected = connect(url, reused);
+        if (!connected) {
+            return connected.error();
+        }
+
+        esp_http_client_set_method(client_, method);
+
+        // Headers stick to the handle, so drop the ones this request lacks
+        for (const std::string& header : header_names_) {
+            if (headers.find(header) == headers.end()) {
+                esp_http_client_delete_header(client_, header.c_str());
+            }
+        }
+        header_names_.clear();
+
+        if (data.empty()) {
+            esp_http_client_set_post_field(client_, nullptr, 0);
+        } else {
+            esp_http_client_set_post_field(client_, data.c_str(), data.length());
+        }
+
+        // Set headers
+        for (const auto& header : headers) {
+            esp_http_client_set_header(client_, header.first.c_str(), header.second.c_str());
+            header_names_.push_back(header.first);
+        }
+
+        // Reset request state
+        response_data_.clear();
+
+        // Perform request
+        esp_err_t err = esp_http_client_perform(client_);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "HTTP %s request failed: %s", name, esp_err_to_name(err));
+            close();
+            if (reused && method == HTTP_METHOD_GET && attempt == 0) {
+                continue;
+            }
+            return owlet_error(OwletErrc::ConnectionFailed,
+                               method == HTTP_METHOD_POST ? "HTTP POST request failed" : "HTTP GET request failed", err);
+        }
+
+        int status_code = esp_http_client_get_status_code(client_);
+        ESP_LOGI(TAG, "HTTP %s Status = %d", name, status_code);
+        if (status_code < 200 || status_code >= 300) {
+            return owlet_error(OwletErrc::HttpStatus,
+                               method == HTTP_METHOD_POST ? "HTTP POST returned non-2xx status"
+                                                          : "HTTP GET returned non-2xx status", status_code);
+        }
+        return std::move(response_data_);
+    }
+}
+
+OwletResult<std::string> EspHttpClient::post(const std::string& url, const std::string& data,
+                                            const std::map<std::string, std::string>& headers) {
+    return perform(HTTP_METHOD_POST, "POST", url, data, headers);
+}
+
+OwletResult<std::string> EspHttpClient::get(const std::string& url,
+                                           const std::map<std::string, std::string>& headers) {
+    static const std::string no_data;
+    return perform(HTTP_METHOD_GET, "GET", url, no_data, headers);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "http_client.h"
+#include <esp_http_client.h>
+#include <string>
+#include <map>
+#include <vector>
+
+// HttpClient over the ESP-IDF client. Each instance keeps one keep-alive
+// connection open and reuses it for every request to the same scheme, host
+// and port, so PooledHttpClient really pools connections. An instance must
+// only be used by one thread at a time.
+class EspHttpClient : public HttpClient {
+public:
+    EspHttpClient();
+    ~EspHttpClient() override;
+
+    OwletResult<std::string> post(const std::string& url, const std::string& data,
+                                  const std::map<std::string, std::string>& headers) override;
+    OwletResult<std::string> get(const std::string& url,
+                                 const std::map<std::string, std::string>& headers) override;
+    void set_chunk_callback(ChunkCallback callback) override;
+
+private:
+    static esp_err_t http_event_handler(esp_http_client_event_t *evt);
+    static std::string url_origin(const std::string& url);
+
+    OwletResult<std::string> perform(esp_http_client_method_t method, const char* name,
+                                     const std::string& url, const std::string& data,
+                                     const std::map<std::string, std::string>& headers);
+    OwletStatus connect(const std::string& url, bool& reused);
+    void close();
+
+    // Persistent connection and the origin it was opened for
+    esp_http_client_handle_t client_;
+    std::string origin_;
+    // Headers set on the handle by the previous request
+    std::vector<std::string> header_names_;
+
+    // Per-instance request state so several clients can run concurrently
+    std::string response_data_;
+    ChunkCallback chunk_callback_;
+};
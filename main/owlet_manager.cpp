@@ -0,0 +1,216 @@
+#include "owlet_manager.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_pthread.h"
+#include <chrono>
+#include <utility>
+
+static const char* TAG = "OWLET_MANAGER";
+
+// Workers run auth, HTTP and the properties callback, far more than the
+// default pthread stack allows
+static constexpr size_t kWorkerStackSize = 8192;
+static constexpr size_t kWorkerPriority = 5;
+// Shortest poll interval; anything faster just hammers the cloud
+static constexpr uint32_t kMinIntervalMs = 1000;
+
+OwletManager::OwletManager(std::shared_ptr<HttpClient> transport)
+    : transport_(std::move(transport)), running_(false) {
+    ESP_LOGI(TAG, "Owlet manager initialized");
+}
+
+OwletManager::~OwletManager() {
+    stop();
+    ESP_LOGI(TAG, "Owlet manager destroyed");
+}
+
+int64_t OwletManager::now_ms() {
+    return esp_timer_get_time() / 1000;
+}
+
+size_t OwletManager::add_account(const OwletAccountConfig& config) {
+    std::unique_ptr<Account> account(new Account());
+    account->api.reset(new OwletAPI(config.region, config.user, config.password,
+                                    config.token, config.expiry, config.refresh, transport_));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    accounts_.push_back(std::move(account));
+    ESP_LOGI(TAG, "Added account %u", (unsigned)(accounts_.size() - 1));
+    return accounts_.size() - 1;
+}
+
+OwletStatus OwletManager::add_device(size_t account, const std::string& device, uint32_t interval_ms) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (account >= accounts_.size()) {
+            return owlet_error(OwletErrc::InvalidArgument, "Unknown account");
+        }
+        if (interval_ms < kMinIntervalMs) {
+            ESP_LOGE(TAG, "Poll interval %u ms is below %u ms", (unsigned)interval_ms, (unsigned)kMinIntervalMs);
+            return owlet_error(OwletErrc::InvalidArgument, "Poll interval too short");
+        }
+        devices_.push_back(Device{account, device, interval_ms});
+        schedule_.push(Poll{now_ms(), devices_.size() - 1});
+    }
+    wake_.notify_one();
+    return {};
+}
+
+void OwletManager::set_properties_callback(PropertiesCallback callback) {
+    callback_ = std::move(callback);
+}
+
+void OwletManager::run_poll(const Poll& poll) {
+    Account* account;
+    size_t account_id;
+    std::string serial;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const Device& device = devices_[poll.device];
+        account_id = device.account;
+        serial = device.serial;
+        account = accounts_[account_id].get();
+    }
+
+    // The callback runs after the account lock is released so it may call
+    // back into the manager, e.g. get_tokens() to persist refreshed tokens
+    OwletResult<PropertiesResponse> properties = fetch_properties(*account, account_id, serial);
+    if (callback_) {
+        callback_(account_id, serial, properties);
+    }
+}
+
+OwletResult<PropertiesResponse> OwletManager::fetch_properties(Account& account, size_t account_id,
+                                                               const std::string& serial) {
+    std::lock_guard<std::mutex> account_lock(account.mutex);
+    OwletStatus auth = account.api->validate_authentication();
+    if (!auth) {
+        auth = account.api->authenticate();
+    }
+    if (!auth) {
+        ESP_LOGW(TAG, "Account %u authentication failed: %s", (unsigned)account_id, auth.error().what());
+        return auth.error();
+    }
+    return account.api->get_properties(serial);
+}
+
+void OwletManager::reschedule(const Poll& poll, int64_t now) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Skip missed slots instead of bursting to catch up
+        int64_t due = poll.due_ms + devices_[poll.device].interval_ms;
+        schedule_.push(Poll{due > now ? due : now, poll.device});
+    }
+    wake_.notify_one();
+}
+
+size_t OwletManager::run_pending(int64_t now) {
+    // Take the due polls up front so rescheduled ones wait for the next call
+    std::vector<Poll> due;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (!schedule_.empty() && schedule_.top().due_ms <= now) {
+            due.push_back(schedule_.top());
+            schedule_.pop();
+        }
+    }
+
+    for (const Poll& poll : due) {
+        run_poll(poll);
+        reschedule(poll, now + 1);
+    }
+    return due.size();
+}
+
+void OwletManager::worker_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        if (schedule_.empty()) {
+            wake_.wait(lock);
+            continue;
+        }
+        int64_t now = now_ms();
+        if (schedule_.top().due_ms > now) {
+            wake_.wait_for(lock, std::chrono::milliseconds(schedule_.top().due_ms - now));
+            continue;
+        }
+
+        Poll poll = schedule_.top();
+        schedule_.pop();
+        lock.unlock();
+        run_poll(poll);
+        reschedule(poll, now_ms());
+        lock.lock();
+    }
+}
+
+OwletStatus OwletManager::start(size_t workers) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+        return owlet_error(OwletErrc::InvalidArgument, "Owlet manager already running");
+    }
+    if (workers == 0) {
+        return owlet_error(OwletErrc::InvalidArgument, "Owlet manager needs at least one worker");
+    }
+
+    // std::thread picks up its stack size and priority from the calling
+    // thread's pthread config, so swap ours in only while spawning
+    esp_pthread_cfg_t previous;
+    bool had_previous = esp_pthread_get_cfg(&previous) == ESP_OK;
+    esp_pthread_cfg_t cfg = esp_pthread_get_default_config();
+    cfg.stack_size = kWorkerStackSize;
+    cfg.prio = kWorkerPriority;
+    cfg.thread_name = "owlet_poll";
+    esp_err_t err = esp_pthread_set_cfg(&cfg);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to configure worker threads: %d", err);
+        return owlet_error(OwletErrc::InvalidArgument, "Worker thread config rejected", err);
+    }
+
+    running_ = true;
+    for (size_t i = 0; i < workers; ++i) {
+        workers_.emplace_back(&OwletManager::worker_loop, this);
+    }
+    if (had_previous) {
+        esp_pthread_set_cfg(&previous);
+    } else {
+        esp_pthread_cfg_t fallback = esp_pthread_get_default_config();
+        esp_pthread_set_cfg(&fallback);
+    }
+    ESP_LOGI(TAG, "Started %u workers", (unsigned)workers);
+    return {};
+}
+
+void OwletManager::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+    ESP_LOGI(TAG, "Stopped workers");
+}
+
+OwletResult<TokenDict> OwletManager::get_tokens(size_t account) {
+    Account* entry;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (account >= accounts_.size()) {
+            return owlet_error(OwletErrc::InvalidArgument, "Unknown account");
+        }
+        entry = accounts_[account].get();
+    }
+    std::lock_guard<std::mutex> account_lock(entry->mutex);
+    return entry->api->get_tokens();
+}
+
+size_t OwletManager::account_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return accounts_.size();
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <optional>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <queue>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "owlet_api.h"
+
+struct OwletAccountConfig {
+    std::string region;
+    std::optional<std::string> user;
+    std::optional<std::string> password;
+    std::optional<std::string> token;
+    std::optional<double> expiry;
+    std::optional<std::string> refresh;
+};
+
+// Runs many Owlet accounts and socks over one shared transport.
+//
+// Every account gets its own OwletAPI, so tokens and auth headers stay
+// isolated, but all of them issue requests through the same HttpClient
+// (typically a SingleFlightHttpClient over a PooledHttpClient). Property
+// polls for all socks share one schedule that is drained either by
+// run_pending() or by worker threads started with start(). Requests for
+// one account are serialised; different accounts run concurrently.
+class OwletManager {
+public:
+    using PropertiesCallback = std::function<void(size_t account, const std::string& device,
+                                                  const OwletResult<PropertiesResponse>& properties)>;
+
+    explicit OwletManager(std::shared_ptr<HttpClient> transport);
+    ~OwletManager();
+
+    // Returns the account id used by the other methods
+    size_t add_account(const OwletAccountConfig& config);
+    // Polls `device` every `interval_ms` (at least one second)
+    OwletStatus add_device(size_t account, const std::string& device, uint32_t interval_ms);
+    // Set before start(); workers read it without locking. The callback runs
+    // on the worker threads, concurrently for different devices, with no
+    // manager lock held, so it may call get_tokens() and must be thread-safe.
+    void set_properties_callback(PropertiesCallback callback);
+
+    // Run every poll that is due at `now` (milliseconds on the esp_timer
+    // clock) on the calling thread. Returns the number of polls run.
+    size_t run_pending(int64_t now);
+
+    OwletStatus start(size_t workers);
+    void stop();
+
+    OwletResult<TokenDict> get_tokens(size_t account);
+    size_t account_count() const;
+
+private:
+    struct Account {
+        std::unique_ptr<OwletAPI> api;
+        std::mutex mutex;
+    };
+
+    struct Poll {
+        int64_t due_ms;
+        size_t device;
+    };
+
+    struct PollLater {
+        bool operator()(const Poll& a, const Poll& b) const { return a.due_ms > b.due_ms; }
+    };
+
+    struct Device {
+        size_t account;
+        std::string serial;
+        uint32_t interval_ms;
+    };
+
+    void run_poll(const Poll& poll);
+    OwletResult<PropertiesResponse> fetch_properties(Account& account, size_t account_id,
+                                                     const std::string& serial);
+    void reschedule(const Poll& poll, int64_t now);
+    void worker_loop();
+    static int64_t now_ms();
+
+    std::shared_ptr<HttpClient> transport_;
+    std::vector<std::unique_ptr<Account>> accounts_;
+    std::vector<Device> devices_;
+    std::priority_queue<Poll, std::vector<Poll>, PollLater> schedule_;
+    PropertiesCallback callback_;
+    bool running_;
+    std::vector<std::thread> workers_;
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+};
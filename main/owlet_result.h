@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+// Error codes reported by OwletAPI and HttpClient implementations.
+// These are plain values so failures can be propagated without exceptions
+// or heap allocation (the component builds with -fno-exceptions -fno-rtti).
+enum class OwletErrc : uint8_t {
+    Ok = 0,
+    InvalidRegion,
+    MissingCredentials,
+    AuthenticationFailed,
+    TokenMissing,
+    TokenExpired,
+    RefreshUnavailable,
+    ClientInitFailed,
+    ConnectionFailed,
+    HttpStatus,
+    InvalidResponse,
+    DevicesUnavailable,
+    NotImplemented,
+    InvalidArgument,
+    CapacityExceeded,
+    StorageFailed,
+};
+
+inline const char* owlet_errc_name(OwletErrc code) {
+    switch (code) {
+        case OwletErrc::Ok:                   return "ok";
+        case OwletErrc::InvalidRegion:        return "invalid region";
+        case OwletErrc::MissingCredentials:   return "missing credentials";
+        case OwletErrc::AuthenticationFailed: return "authentication failed";
+        case OwletErrc::TokenMissing:         return "token missing";
+        case OwletErrc::TokenExpired:         return "token expired";
+        case OwletErrc::RefreshUnavailable:   return "refresh unavailable";
+        case OwletErrc::ClientInitFailed:     return "http client init failed";
+        case OwletErrc::ConnectionFailed:     return "connection failed";
+        case OwletErrc::HttpStatus:           return "unexpected http status";
+        case OwletErrc::InvalidResponse:      return "invalid response";
+        case OwletErrc::DevicesUnavailable:   return "devices unavailable";
+        case OwletErrc::NotImplemented:       return "not implemented";
+        case OwletErrc::InvalidArgument:      return "invalid argument";
+        case OwletErrc::CapacityExceeded:     return "capacity exceeded";
+        case OwletErrc::StorageFailed:        return "storage failed";
+    }
+    return "unknown";
+}
+
+// Failure description. `context` must point to a string with static storage
+// duration (a literal or a TAG); it is never copied or freed. `detail` carries
+// an optional numeric cause such as an HTTP status or esp_err_t.
+struct OwletError {
+    OwletErrc code = OwletErrc::Ok;
+    const char* context = nullptr;
+    int detail = 0;
+
+    const char* what() const { return context ? context : owlet_errc_name(code); }
+};
+
+inline OwletError owlet_error(OwletErrc code, const char* context = nullptr, int detail = 0) {
+    return OwletError{code, context, detail};
+}
+
+// Minimal expected<T, OwletError>: holds either a value or an error.
+// Accessing the value of an error result is a programming error (asserted).
+template <typename T>
+class [[nodiscard]] OwletResult {
+public:
+    OwletResult(const T& value) : value_(value) {}
+    OwletResult(T&& value) : value_(std::move(value)) {}
+    OwletResult(const OwletError& error) : error_(error) {}
+
+    bool ok() const { return value_.has_value(); }
+    explicit operator bool() const { return ok(); }
+
+    T& value() & { assert(ok()); return *value_; }
+    const T& value() const & { assert(ok()); return *value_; }
+    T&& value() && { assert(ok()); return std::move(*value_); }
+
+    T& operator*() & { assert(ok()); return *value_; }
+    const T& operator*() const & { assert(ok()); return *value_; }
+    T* operator->() { assert(ok()); return &*value_; }
+    const T* operator->() const { assert(ok()); return &*value_; }
+
+    const OwletError& error() const { return error_; }
+    OwletErrc code() const { return error_.code; }
+
+private:
+    std::optional<T> value_;
+    OwletError error_;
+};
+
+// Result of an operation that produces no value. Default-constructed is success.
+template <>
+class [[nodiscard]] OwletResult<void> {
+public:
+    OwletResult() = default;
+    OwletResult(const OwletError& error) : error_(error) {}
+
+    bool ok() const { return error_.code == OwletErrc::Ok; }
+    explicit operator bool() const { return ok(); }
+
+    const OwletError& error() const { return error_; }
+    OwletErrc code() const { return error_.code; }
+
+private:
+    OwletError error_;
+};
+
+using OwletStatus = OwletResult<void>;
@@ -0,0 +1,70 @@
+#include "partition_block_storage.h"
+#include "esp_partition.h"
+#include "esp_log.h"
+
+static const char* TAG = "PARTITION_BLOCK_STORAGE";
+
+static constexpr size_t kSectorSize = 4096;
+
+PartitionBlockStorage::PartitionBlockStorage(const char* label, size_t block_size)
+    : partition_(nullptr), block_size_(block_size), capacity_(0) {
+    if (block_size_ == 0 || kSectorSize % block_size_ != 0) {
+        ESP_LOGE(TAG, "Block size %u does not divide the flash sector size", (unsigned)block_size_);
+        return;
+    }
+
+    partition_ = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    if (!partition_) {
+        ESP_LOGE(TAG, "Partition not found: %s", label);
+        return;
+    }
+
+    // Only whole sectors are used so erasing never touches a neighbour
+    capacity_ = (partition_->size / kSectorSize) * (kSectorSize / block_size_);
+    ESP_LOGI(TAG, "Using partition %s (%u blocks of %u bytes)", label,
+             (unsigned)capacity_, (unsigned)block_size_);
+}
+
+PartitionBlockStorage::~PartitionBlockStorage() {
+    ESP_LOGI(TAG, "Partition block storage destroyed");
+}
+
+OwletStatus PartitionBlockStorage::write(size_t slot, const void* data, size_t len) {
+    if (!partition_) {
+        return owlet_error(OwletErrc::StorageFailed, "Partition not available");
+    }
+    if (slot >= capacity_ || len > block_size_) {
+        return owlet_error(OwletErrc::InvalidArgument, "Block write out of range");
+    }
+
+    size_t offset = slot * block_size_;
+    if (offset % kSectorSize == 0) {
+        esp_err_t err = esp_partition_erase_range(partition_, offset, kSectorSize);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to erase sector at 0x%x: %s", (unsigned)offset, esp_err_to_name(err));
+            return owlet_error(OwletErrc::StorageFailed, "Partition erase failed", err);
+        }
+    }
+
+    esp_err_t err = esp_partition_write(partition_, offset, data, len);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to write block %u: %s", (unsigned)slot, esp_err_to_name(err));
+        return owlet_error(OwletErrc::StorageFailed, "Partition write failed", err);
+    }
+    return {};
+}
+
+OwletStatus PartitionBlockStorage::read(size_t slot, size_t offset, void* out, size_t len) {
+    if (!partition_) {
+        return owlet_error(OwletErrc::StorageFailed, "Partition not available");
+    }
+    if (slot >= capacity_ || offset + len > block_size_) {
+        return owlet_error(OwletErrc::InvalidArgument, "Block read out of range");
+    }
+
+    esp_err_t err = esp_partition_read(partition_, slot * block_size_ + offset, out, len);
+    if (err != ESP_OK) {
+        return owlet_error(OwletErrc::StorageFailed, "Partition read failed", err);
+    }
+    return {};
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "block_storage.h"
+
+// Forward declaration for ESP-IDF type
+struct esp_partition_t;
+
+// Block storage on a raw flash data partition. The partition is treated as
+// a ring of blocks; each 4 KiB sector is erased when the first block in it
+// is written.
+class PartitionBlockStorage : public BlockStorage {
+public:
+    PartitionBlockStorage(const char* label, size_t block_size);
+    ~PartitionBlockStorage() override;
+
+    size_t block_size() const override { return block_size_; }
+    size_t capacity() const override { return capacity_; }
+    size_t erase_blocks() const override { return block_size_ ? 4096 / block_size_ : 1; }
+    OwletStatus write(size_t slot, const void* data, size_t len) override;
+    OwletStatus read(size_t slot, size_t offset, void* out, size_t len) override;
+
+private:
+    const esp_partition_t* partition_;
+    size_t block_size_;
+    size_t capacity_;
+};
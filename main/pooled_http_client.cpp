@@ -0,0 +1,73 @@
+#include "pooled_http_client.h"
+#include "esp_log.h"
+#include <utility>
+
+static const char* TAG = "POOLED_HTTP_CLIENT";
+
+PooledHttpClient::PooledHttpClient(Factory factory, size_t size)
+    : factory_(std::move(factory)), size_(size ? size : 1), created_(0) {
+    ESP_LOGI(TAG, "Pooled HTTP Client initialized with %u connections", (unsigned)size_);
+}
+
+PooledHttpClient::~PooledHttpClient() {
+    ESP_LOGI(TAG, "Pooled HTTP Client destroyed");
+}
+
+OwletResult<std::shared_ptr<HttpClient>> PooledHttpClient::acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    available_.wait(lock, [this] { return !idle_.empty() || created_ < size_; });
+
+    if (!idle_.empty()) {
+        std::shared_ptr<HttpClient> client = std::move(idle_.back());
+        idle_.pop_back();
+        return client;
+    }
+
+    // Reserve the slot before unlocking so the factory runs outside the lock
+    ++created_;
+    lock.unlock();
+    std::shared_ptr<HttpClient> client = factory_();
+    if (!client) {
+        lock.lock();
+        --created_;
+        available_.notify_one();
+        ESP_LOGE(TAG, "HTTP client factory failed");
+        return owlet_error(OwletErrc::ClientInitFailed, "HTTP client factory failed");
+    }
+    return client;
+}
+
+void PooledHttpClient::release(std::shared_ptr<HttpClient> client) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        idle_.push_back(std::move(client));
+    }
+    available_.notify_one();
+}
+
+OwletResult<std::string> PooledHttpClient::post(const std::string& url, const std::string& data, 
+                                                const std::map<std::string, std::string>& headers) {
+    OwletResult<std::shared_ptr<HttpClient>> client = acquire();
+    if (!client) {
+        return client.error();
+    }
+    OwletResult<std::string> response = (*client)->post(url, data, headers);
+    release(std::move(*client));
+    return response;
+}
+
+OwletResult<std::string> PooledHttpClient::get(const std::string& url, 
+                                               const std::map<std::string, std::string>& headers) {
+    OwletResult<std::shared_ptr<HttpClient>> client = acquire();
+    if (!client) {
+        return client.error();
+    }
+    OwletResult<std::string> response = (*client)->get(url, headers);
+    release(std::move(*client));
+    return response;
+}
+
+size_t PooledHttpClient::created() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return created_;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "http_client.h"
+#include <string>
+#include <map>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+
+// Bounded pool of HTTP clients shared by many OwletAPI instances. Each
+// request borrows an idle client (creating one lazily up to `size`) and
+// blocks while all of them are busy, so the number of open connections
+// stays fixed no matter how many accounts use the pool.
+class PooledHttpClient : public HttpClient {
+public:
+    using Factory = std::function<std::shared_ptr<HttpClient>()>;
+
+    PooledHttpClient(Factory factory, size_t size);
+    ~PooledHttpClient() override;
+
+    OwletResult<std::string> post(const std::string& url, const std::string& data, 
+                                  const std::map<std::string, std::string>& headers) override;
+    OwletResult<std::string> get(const std::string& url, 
+                                 const std::map<std::string, std::string>& headers) override;
+
+    size_t created() const;
+
+private:
+    OwletResult<std::shared_ptr<HttpClient>> acquire();
+    void release(std::shared_ptr<HttpClient> client);
+
+    Factory factory_;
+    size_t size_;
+    size_t created_;
+    std::vector<std::shared_ptr<HttpClient>> idle_;
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+};
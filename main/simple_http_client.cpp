@@ -13,8 +13,8 @@ SimpleHttpClient::~SimpleHttpClient() {
     ESP_LOGI(TAG, "Simple HTTP Client destroyed");
 }
 
-bool SimpleHttpClient::post(const std::string& url, const std::string& data, 
-                           const std::map<std::string, std::string>& headers, std::string& response) {
+OwletResult<std::string> SimpleHttpClient::post(const std::string& url, const std::string& data, 
+                                               const std::map<std::string, std::string>& headers) {
     ESP_LOGI(TAG, "Simple HTTP POST to: %s", url.c_str());
     ESP_LOGI(TAG, "Data: %s", data.c_str());
     
@@ -24,12 +24,11 @@ bool SimpleHttpClient::post(const std::string& url, const std::string& data,
     }
     
     // Return a mock response
-    response = "{\"mock\": \"response\", \"status\": \"success\"}";
-    return true;
+    return std::string("{\"mock\": \"response\", \"status\": \"success\"}");
 }
 
-bool SimpleHttpClient::get(const std::string& url, const std::map<std::string, std::string>& headers, 
-                          std::string& response) {
+OwletResult<std::string> SimpleHttpClient::get(const std::string& url, 
+                                              const std::map<std::string, std::string>& headers) {
     ESP_LOGI(TAG, "Simple HTTP GET from: %s", url.c_str());
     
     // Log headers
@@ -38,6 +37,5 @@ bool SimpleHttpClient::get(const std::string& url, const std::map<std::string, s
     }
     
     // Return a mock response
-    response = "{\"mock\": \"response\", \"status\": \"success\"}";
-    return true;
+    return std::string("{\"mock\": \"response\", \"status\": \"success\"}");
 } 
\ No newline at end of file
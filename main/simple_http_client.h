@@ -10,8 +10,8 @@ public:
     SimpleHttpClient();
     ~SimpleHttpClient() override;
 
-    bool post(const std::string& url, const std::string& data, 
-              const std::map<std::string, std::string>& headers, std::string& response) override;
-    bool get(const std::string& url, const std::map<std::string, std::string>& headers, 
-             std::string& response) override;
+    OwletResult<std::string> post(const std::string& url, const std::string& data, 
+                                  const std::map<std::string, std::string>& headers) override;
+    OwletResult<std::string> get(const std::string& url, 
+                                 const std::map<std::string, std::string>& headers) override;
 }; 
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "single_flight_http_client.h"
+#include "esp_log.h"
+#include <utility>
+
+static const char* TAG = "SINGLE_FLIGHT_HTTP_CLIENT";
+
+SingleFlightHttpClient::SingleFlightHttpClient(std::shared_ptr<HttpClient> inner)
+    : inner_(std::move(inner)), coalesced_(0) {
+    ESP_LOGI(TAG, "Single-flight HTTP Client initialized");
+}
+
+SingleFlightHttpClient::~SingleFlightHttpClient() {
+    ESP_LOGI(TAG, "Single-flight HTTP Client destroyed");
+}
+
+OwletResult<std::string> SingleFlightHttpClient::post(const std::string& url, const std::string& data, 
+                                                      const std::map<std::string, std::string>& headers) {
+    return inner_->post(url, data, headers);
+}
+
+OwletResult<std::string> SingleFlightHttpClient::get(const std::string& url, 
+                                                     const std::map<std::string, std::string>& headers) {
+    std::string key = url;
+    for (const auto& header : headers) {
+        key += '\n';
+        key += header.first;
+        key += ':';
+        key += header.second;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto existing = flights_.find(key);
+    if (existing != flights_.end()) {
+        // Hold a reference so the result outlives the leader erasing the entry
+        std::shared_ptr<Flight> flight = existing->second;
+        ++coalesced_;
+        landed_.wait(lock, [&flight] { return flight->result.has_value(); });
+        return *flight->result;
+    }
+
+    std::shared_ptr<Flight> flight = std::make_shared<Flight>();
+    flights_.emplace(key, flight);
+    lock.unlock();
+
+    OwletResult<std::string> response = inner_->get(url, headers);
+
+    lock.lock();
+    flight->result = response;
+    flights_.erase(key);
+    lock.unlock();
+    landed_.notify_all();
+    return response;
+}
+
+size_t SingleFlightHttpClient::coalesced() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return coalesced_;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "http_client.h"
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <optional>
+
+// Coalesces identical concurrent GET requests: while one caller is fetching
+// a URL with a given set of headers, other callers asking for the same thing
+// wait and receive a copy of that result instead of issuing their own.
+// Headers are part of the key, so requests carrying different auth tokens
+// are never merged. POSTs are not idempotent and always pass through.
+//
+// Under OwletManager each account's requests are also serialised, so in
+// practice only the same login registered as several accounts ever
+// coalesces; distinct accounts polling the same sock do not.
+class SingleFlightHttpClient : public HttpClient {
+public:
+    explicit SingleFlightHttpClient(std::shared_ptr<HttpClient> inner);
+    ~SingleFlightHttpClient() override;
+
+    OwletResult<std::string> post(const std::string& url, const std::string& data, 
+                                  const std::map<std::string, std::string>& headers) override;
+    OwletResult<std::string> get(const std::string& url, 
+                                 const std::map<std::string, std::string>& headers) override;
+
+    // Number of requests answered by another caller's in-flight request
+    size_t coalesced() const;
+
+private:
+    struct Flight {
+        std::optional<OwletResult<std::string>> result;
+    };
+
+    std::shared_ptr<HttpClient> inner_;
+    std::map<std::string, std::shared_ptr<Flight>> flights_;
+    size_t coalesced_;
+    mutable std::mutex mutex_;
+    std::condition_variable landed_;
+};
@@ -0,0 +1,603 @@
+#include "vitals_store.h"
+#include "owlet_api.h"
+#include "esp_log.h"
+#include <cstring>
+
+static const char* TAG = "VITALS_STORE";
+
+static constexpr uint32_t kBlockMagic = 0x534C5456; // "VTLS"
+static constexpr size_t kPayloadBits = kVitalsPayloadSize * 8;
+static constexpr size_t kMaxSeries = 255;
+static constexpr size_t kMaxBuckets = 4096;
+// 2020-01-01T00:00:00Z; anything earlier is uptime, not wall-clock time
+static constexpr uint32_t kMinWallClock = 1577836800;
+
+namespace {
+
+uint32_t float_bits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+float bits_float(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// MSB-first bit writer over a zero-initialised payload
+void put_bits(uint8_t* payload, uint16_t& pos, uint32_t value, unsigned count) {
+    while (count > 0) {
+        unsigned free_bits = 8 - (pos & 7);
+        unsigned take = count < free_bits ? count : free_bits;
+        uint32_t chunk = (value >> (count - take)) & ((1u << take) - 1);
+        payload[pos >> 3] |= (uint8_t)(chunk << (free_bits - take));
+        pos += take;
+        count -= take;
+    }
+}
+
+// Reads past the payload yield zeros; the decoder notices it overran
+// header.bits and stops
+uint32_t get_bits(const uint8_t* payload, uint32_t& pos, unsigned count) {
+    uint32_t value = 0;
+    while (count > 0) {
+        unsigned avail = 8 - (pos & 7);
+        unsigned take = count < avail ? count : avail;
+        uint8_t byte = (pos >> 3) < kVitalsPayloadSize ? payload[pos >> 3] : 0;
+        uint32_t chunk = (byte >> (avail - take)) & ((1u << take) - 1);
+        value = (value << take) | chunk;
+        pos += take;
+        count -= take;
+    }
+    return value;
+}
+
+// Delta-of-delta buckets: '0', '10'+7, '110'+9, '1110'+12, '1111'+32
+unsigned timestamp_bits(int64_t dod) {
+    if (dod == 0) return 1;
+    if (dod >= -63 && dod <= 64) return 2 + 7;
+    if (dod >= -255 && dod <= 256) return 3 + 9;
+    if (dod >= -2047 && dod <= 2048) return 4 + 12;
+    return 4 + 32;
+}
+
+void put_timestamp(uint8_t* payload, uint16_t& pos, int64_t dod) {
+    if (dod == 0) {
+        put_bits(payload, pos, 0x0, 1);
+    } else if (dod >= -63 && dod <= 64) {
+        put_bits(payload, pos, 0x2, 2);
+        put_bits(payload, pos, (uint32_t)(dod + 63), 7);
+    } else if (dod >= -255 && dod <= 256) {
+        put_bits(payload, pos, 0x6, 3);
+        put_bits(payload, pos, (uint32_t)(dod + 255), 9);
+    } else if (dod >= -2047 && dod <= 2048) {
+        put_bits(payload, pos, 0xE, 4);
+        put_bits(payload, pos, (uint32_t)(dod + 2047), 12);
+    } else {
+        put_bits(payload, pos, 0xF, 4);
+        put_bits(payload, pos, (uint32_t)(int32_t)dod, 32);
+    }
+}
+
+int64_t get_timestamp(const uint8_t* payload, uint32_t& pos) {
+    if (get_bits(payload, pos, 1) == 0) return 0;
+    if (get_bits(payload, pos, 1) == 0) return (int64_t)get_bits(payload, pos, 7) - 63;
+    if (get_bits(payload, pos, 1) == 0) return (int64_t)get_bits(payload, pos, 9) - 255;
+    if (get_bits(payload, pos, 1) == 0) return (int64_t)get_bits(payload, pos, 12) - 2047;
+    return (int32_t)get_bits(payload, pos, 32);
+}
+
+unsigned leading_zeros(uint32_t x) {
+    unsigned n = (unsigned)__builtin_clz(x);
+    return n > 31 ? 31 : n;
+}
+
+unsigned trailing_zeros(uint32_t x) {
+    return (unsigned)__builtin_ctz(x);
+}
+
+// Streaming decoder; callers stop as soon as they pass the query range
+class BlockDecoder {
+public:
+    explicit BlockDecoder(const VitalsBlock& block)
+        : block_(block), pos_(0), index_(0), ts_(0), delta_(0), value_(0), leading_(0), trailing_(0) {}
+
+    bool next(VitalsSample& sample) {
+        if (index_ >= block_.header.count || pos_ > block_.header.bits) {
+            return false;
+        }
+        const uint8_t* payload = block_.payload;
+        if (index_ == 0) {
+            ts_ = block_.header.first_ts;
+            value_ = get_bits(payload, pos_, 32);
+        } else {
+            delta_ += get_timestamp(payload, pos_);
+            ts_ = (uint32_t)(ts_ + delta_);
+            if (get_bits(payload, pos_, 1) != 0) {
+                if (get_bits(payload, pos_, 1) != 0) {
+                    leading_ = get_bits(payload, pos_, 5);
+                    unsigned meaningful = get_bits(payload, pos_, 5) + 1;
+                    trailing_ = 32 - leading_ - meaningful;
+                }
+                unsigned meaningful = 32 - leading_ - trailing_;
+                value_ ^= get_bits(payload, pos_, meaningful) << trailing_;
+            }
+        }
+        if (pos_ > block_.header.bits) {
+            // Corrupt payload: the sample ran past the encoded bits
+            return false;
+        }
+        ++index_;
+        sample.timestamp = ts_;
+        sample.value = bits_float(value_);
+        return true;
+    }
+
+private:
+    const VitalsBlock& block_;
+    uint32_t pos_;
+    uint16_t index_;
+    uint32_t ts_;
+    int64_t delta_;
+    uint32_t value_;
+    unsigned leading_;
+    unsigned trailing_;
+};
+
+// Cheap structural checks that hold for every block append() produces: the
+// first sample takes 32 bits and each later one at least 2
+bool header_valid(const VitalsBlockHeader& header) {
+    return header.magic == kBlockMagic && header.count > 0 && header.bits >= 32 &&
+           header.bits <= kPayloadBits && (uint32_t)(header.count - 1) * 2 <= header.bits - 32u &&
+           header.first_ts <= header.last_ts;
+}
+
+uint32_t crc32_update(uint32_t crc, const void* data, size_t len) {
+    // Nibble-table CRC-32 (IEEE), small enough to keep in flash
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < len; ++i) {
+        crc ^= bytes[i];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+    }
+    return crc;
+}
+
+uint32_t block_crc(const VitalsBlock& block) {
+    VitalsBlockHeader header = block.header;
+    header.crc = 0;
+    uint32_t crc = crc32_update(0xFFFFFFFF, &header, sizeof(header));
+    return ~crc32_update(crc, block.payload, sizeof(block.payload));
+}
+
+bool block_overlaps(const VitalsBlockHeader& header, uint8_t series, uint32_t from, uint32_t to) {
+    return header_valid(header) && header.series == series &&
+           header.last_ts >= from && header.first_ts <= to;
+}
+
+void bucket_add(VitalsBucket& bucket, uint32_t count, float min, float max, float sum) {
+    if (bucket.count == 0) {
+        bucket.min = min;
+        bucket.max = max;
+    } else {
+        if (min < bucket.min) bucket.min = min;
+        if (max > bucket.max) bucket.max = max;
+    }
+    bucket.count += count;
+    bucket.sum += sum;
+}
+
+} // namespace
+
+VitalsStore::VitalsStore(size_t hot_blocks, std::shared_ptr<BlockStorage> cold_storage)
+    : hot_(hot_blocks),
+      hot_head_(0),
+      hot_count_(0),
+      cold_(cold_storage),
+      cold_head_(0),
+      cold_count_(0),
+      next_sequence_(1),
+      samples_(0) {
+    if (cold_ && cold_->block_size() != kVitalsBlockSize) {
+        ESP_LOGE(TAG, "Cold storage block size %u does not match %u, cold tier disabled",
+                 (unsigned)cold_->block_size(), (unsigned)kVitalsBlockSize);
+        cold_.reset();
+    }
+    if (cold_ && (cold_->erase_blocks() == 0 || cold_->capacity() < cold_->erase_blocks() ||
+                  cold_->capacity() == 0)) {
+        // Missing partition or unopenable file; spilling would divide by zero
+        ESP_LOGE(TAG, "Cold storage holds %u blocks but erases %u at a time, cold tier disabled",
+                 (unsigned)cold_->capacity(), (unsigned)cold_->erase_blocks());
+        cold_.reset();
+    }
+    if (cold_) {
+        recover();
+    }
+    ESP_LOGI(TAG, "Vitals store initialized: %u hot blocks, %u cold blocks (%u recovered)",
+             (unsigned)hot_blocks, (unsigned)(cold_ ? cold_->capacity() : 0), (unsigned)cold_count_);
+}
+
+VitalsStore::~VitalsStore() {
+    ESP_LOGI(TAG, "Vitals store destroyed");
+}
+
+void VitalsStore::recover() {
+    // Valid blocks form one run of the ring from the oldest to the newest
+    // sequence; torn blocks inside it are holes that readers skip
+    size_t capacity = cold_->capacity();
+    size_t newest_slot = 0;
+    size_t oldest_slot = 0;
+    uint32_t newest_sequence = 0;
+    uint32_t oldest_sequence = UINT32_MAX;
+    bool found = false;
+    VitalsBlock block;
+    for (size_t slot = 0; slot < capacity; ++slot) {
+        const VitalsBlockHeader& header = block.header;
+        if (!cold_->read(slot, 0, &block, sizeof(block)) || !header_valid(header)) {
+            continue;
+        }
+        if (header.crc != block_crc(block)) {
+            ESP_LOGW(TAG, "Dropping torn cold block in slot %u", (unsigned)slot);
+            continue;
+        }
+        found = true;
+        samples_ += header.count;
+        if (header.sequence >= newest_sequence) {
+            newest_sequence = header.sequence;
+            newest_slot = slot;
+        }
+        if (header.sequence <= oldest_sequence) {
+            oldest_sequence = header.sequence;
+            oldest_slot = slot;
+        }
+    }
+    if (found) {
+        cold_count_ = (newest_slot + capacity - oldest_slot) % capacity + 1;
+        cold_head_ = (newest_slot + 1) % capacity;
+        next_sequence_ = newest_sequence + 1;
+    }
+}
+
+OwletResult<uint8_t> VitalsStore::add_series(const std::string& property) {
+    for (size_t i = 0; i < series_names_.size(); ++i) {
+        if (series_names_[i] == property) {
+            return (uint8_t)i;
+        }
+    }
+    if (series_names_.size() >= kMaxSeries) {
+        return owlet_error(OwletErrc::CapacityExceeded, "Too many vitals series");
+    }
+
+    uint8_t series = (uint8_t)series_names_.size();
+    series_names_.push_back(property);
+    open_.emplace_back();
+    start_block(open_.back(), series);
+    ESP_LOGI(TAG, "Tracking property %s as series %u", property.c_str(), (unsigned)series);
+    return series;
+}
+
+void VitalsStore::start_block(OpenBlock& open, uint8_t series) {
+    std::memset(&open.block, 0, sizeof(open.block));
+    open.block.header.magic = kBlockMagic;
+    open.block.header.series = series;
+    open.encoder = Encoder{};
+}
+
+OwletStatus VitalsStore::append(uint8_t series, uint32_t timestamp, float value) {
+    if (series >= open_.size()) {
+        return owlet_error(OwletErrc::InvalidArgument, "Unknown vitals series");
+    }
+    if (cold_ && timestamp < kMinWallClock) {
+        return owlet_error(OwletErrc::InvalidArgument, "Vitals timestamps must be wall-clock time");
+    }
+
+    OpenBlock& open = open_[series];
+    VitalsBlockHeader& header = open.block.header;
+    Encoder& enc = open.encoder;
+    uint32_t bits = float_bits(value);
+
+    if (header.count > 0) {
+        if (timestamp < enc.prev_ts) {
+            return owlet_error(OwletErrc::InvalidArgument, "Vitals timestamps must not go backwards");
+        }
+
+        int64_t delta = (int64_t)timestamp - enc.prev_ts;
+        int64_t dod = delta - enc.prev_delta;
+        uint32_t x = bits ^ enc.prev_value;
+
+        // Work out the exact encoded size before touching the payload
+        unsigned leading = 0;
+        unsigned trailing = 0;
+        bool reuse = false;
+        unsigned needed = timestamp_bits(dod) + 1;
+        if (x != 0) {
+            leading = leading_zeros(x);
+            trailing = trailing_zeros(x);
+            reuse = enc.prev_leading + enc.prev_trailing > 0 &&
+                    leading >= enc.prev_leading && trailing >= enc.prev_trailing;
+            needed += reuse ? 1 + (32 - enc.prev_leading - enc.prev_trailing)
+                            : 1 + 5 + 5 + (32 - leading - trailing);
+        }
+
+        bool dod_fits = dod >= INT32_MIN && dod <= INT32_MAX;
+        if (!dod_fits || header.bits + needed > kPayloadBits || header.count == UINT16_MAX) {
+            OwletStatus status = seal(open);
+            if (!status) {
+                return status;
+            }
+        } else {
+            uint8_t* payload = open.block.payload;
+            put_timestamp(payload, header.bits, dod);
+            if (x == 0) {
+                put_bits(payload, header.bits, 0x0, 1);
+            } else if (reuse) {
+                put_bits(payload, header.bits, 0x2, 2);
+                put_bits(payload, header.bits, x >> enc.prev_trailing,
+                         32 - enc.prev_leading - enc.prev_trailing);
+            } else {
+                unsigned meaningful = 32 - leading - trailing;
+                put_bits(payload, header.bits, 0x3, 2);
+                put_bits(payload, header.bits, leading, 5);
+                put_bits(payload, header.bits, meaningful - 1, 5);
+                put_bits(payload, header.bits, x >> trailing, meaningful);
+                enc.prev_leading = (uint8_t)leading;
+                enc.prev_trailing = (uint8_t)trailing;
+            }
+
+            enc.prev_delta = delta;
+            enc.prev_ts = timestamp;
+            enc.prev_value = bits;
+            header.last_ts = timestamp;
+            if (value < header.min) header.min = value;
+            if (value > header.max) header.max = value;
+            header.sum += value;
+            ++header.count;
+            ++samples_;
+            return {};
+        }
+    }
+
+    // First sample of a block: raw timestamp in the header, raw value in the payload
+    put_bits(open.block.payload, header.bits, bits, 32);
+    header.first_ts = timestamp;
+    header.last_ts = timestamp;
+    header.min = value;
+    header.max = value;
+    header.sum = value;
+    header.count = 1;
+    enc.prev_ts = timestamp;
+    enc.prev_delta = 0;
+    enc.prev_value = bits;
+    ++samples_;
+    return {};
+}
+
+size_t VitalsStore::ingest(const PropertiesResponse& properties, uint32_t timestamp) {
+    size_t appended = 0;
+    for (size_t i = 0; i < series_names_.size(); ++i) {
+        OwletResult<float> value = property_value(properties, series_names_[i]);
+        if (!value) {
+            continue;
+        }
+        if (append((uint8_t)i, timestamp, *value)) {
+            ++appended;
+        }
+    }
+    return appended;
+}
+
+OwletStatus VitalsStore::seal(OpenBlock& open) {
+    uint8_t series = open.block.header.series;
+    if (open.block.header.count == 0) {
+        return {};
+    }
+
+    if (hot_.empty()) {
+        // No hot tier: write straight through to cold storage
+        if (!cold_) {
+            return owlet_error(OwletErrc::CapacityExceeded, "Vitals store has no capacity");
+        }
+        open.block.header.sequence = next_sequence_++;
+        open.block.header.crc = block_crc(open.block);
+        OwletStatus status = write_cold(open.block);
+        if (!status) {
+            return status;
+        }
+        start_block(open, series);
+        return {};
+    }
+
+    if (hot_count_ == hot_.size()) {
+        OwletStatus status = spill_oldest();
+        if (!status) {
+            return status;
+        }
+    }
+
+    open.block.header.sequence = next_sequence_++;
+    open.block.header.crc = block_crc(open.block);
+    hot_[(hot_head_ + hot_count_) % hot_.size()] = open.block;
+    ++hot_count_;
+    start_block(open, series);
+    return {};
+}
+
+OwletStatus VitalsStore::spill_oldest() {
+    VitalsBlock& oldest = hot_[hot_head_];
+    if (cold_) {
+        OwletStatus status = write_cold(oldest);
+        if (!status) {
+            ESP_LOGE(TAG, "Failed to spill block to cold storage: %s", status.error().what());
+            return status;
+        }
+    } else {
+        samples_ -= oldest.header.count;
+    }
+    hot_head_ = (hot_head_ + 1) % hot_.size();
+    --hot_count_;
+    return {};
+}
+
+OwletStatus VitalsStore::write_cold(const VitalsBlock& block) {
+    size_t capacity = cold_->capacity();
+    size_t erase_blocks = cold_->erase_blocks();
+
+    // Starting an erase unit wipes it; once the ring has wrapped those slots
+    // hold the oldest blocks, so stop counting them
+    size_t erased = cold_head_ % erase_blocks == 0 ? erase_blocks : 0;
+    size_t free_slots = capacity - cold_count_;
+    size_t dropped = erased > free_slots ? erased - free_slots : 0;
+    VitalsBlock old;
+    for (size_t i = 0; i < dropped; ++i) {
+        size_t slot = (cold_head_ + free_slots + i) % capacity;
+        // Same test recover() used to count the block in the first place
+        if (cold_->read(slot, 0, &old, sizeof(old)) && header_valid(old.header) &&
+            old.header.crc == block_crc(old)) {
+            samples_ -= old.header.count;
+        }
+    }
+    cold_count_ -= dropped;
+
+    OwletStatus status = cold_->write(cold_head_, &block, sizeof(block));
+    if (!status) {
+        return status;
+    }
+    cold_head_ = (cold_head_ + 1) % capacity;
+    ++cold_count_;
+    return {};
+}
+
+OwletStatus VitalsStore::flush() {
+    for (OpenBlock& open : open_) {
+        OwletStatus status = seal(open);
+        if (!status) {
+            return status;
+        }
+    }
+    if (!cold_) {
+        return {};
+    }
+    while (hot_count_ > 0) {
+        OwletStatus status = spill_oldest();
+        if (!status) {
+            return status;
+        }
+    }
+    return {};
+}
+
+OwletStatus VitalsStore::for_each_block(uint8_t series, uint32_t from, uint32_t to,
+                                        const std::function<void(const VitalsBlock&)>& visitor) {
+    if (series >= open_.size()) {
+        return owlet_error(OwletErrc::InvalidArgument, "Unknown vitals series");
+    }
+
+    // Cold tier first (oldest), reading only headers until a block matches
+    if (cold_ && cold_count_ > 0) {
+        size_t capacity = cold_->capacity();
+        size_t slot = (cold_head_ + capacity - cold_count_) % capacity;
+        VitalsBlock scratch;
+        for (size_t i = 0; i < cold_count_; ++i, slot = (slot + 1) % capacity) {
+            if (!cold_->read(slot, 0, &scratch.header, sizeof(scratch.header)) ||
+                !block_overlaps(scratch.header, series, from, to)) {
+                continue;
+            }
+            OwletStatus status = cold_->read(slot, sizeof(scratch.header), scratch.payload,
+                                             sizeof(scratch.payload));
+            if (!status) {
+                return status;
+            }
+            if (scratch.header.crc != block_crc(scratch)) {
+                ESP_LOGW(TAG, "Skipping corrupt cold block in slot %u", (unsigned)slot);
+                continue;
+            }
+            visitor(scratch);
+        }
+    }
+
+    for (size_t i = 0; i < hot_count_; ++i) {
+        const VitalsBlock& block = hot_[(hot_head_ + i) % hot_.size()];
+        if (block_overlaps(block.header, series, from, to)) {
+            visitor(block);
+        }
+    }
+
+    const VitalsBlock& open = open_[series].block;
+    if (block_overlaps(open.header, series, from, to)) {
+        visitor(open);
+    }
+    return {};
+}
+
+OwletStatus VitalsStore::query(uint8_t series, uint32_t from, uint32_t to,
+                               const std::function<void(const VitalsSample&)>& visitor) {
+    return for_each_block(series, from, to, [&](const VitalsBlock& block) {
+        BlockDecoder decoder(block);
+        VitalsSample sample;
+        while (decoder.next(sample) && sample.timestamp <= to) {
+            if (sample.timestamp >= from) {
+                visitor(sample);
+            }
+        }
+    });
+}
+
+OwletStatus VitalsStore::downsample(uint8_t series, uint32_t from, uint32_t to, uint32_t step,
+                                    std::vector<VitalsBucket>& buckets) {
+    if (step == 0 || to < from) {
+        return owlet_error(OwletErrc::InvalidArgument, "Invalid downsample range");
+    }
+
+    // 64-bit so a full uint32_t range cannot wrap to zero on a 32-bit size_t
+    uint64_t wide_count = ((uint64_t)to - from) / step + 1;
+    if (wide_count > kMaxBuckets) {
+        return owlet_error(OwletErrc::CapacityExceeded, "Too many downsample buckets");
+    }
+    size_t bucket_count = (size_t)wide_count;
+    buckets.assign(bucket_count, VitalsBucket{});
+    for (size_t i = 0; i < bucket_count; ++i) {
+        buckets[i].start = from + (uint32_t)(i * step);
+    }
+
+    return for_each_block(series, from, to, [&](const VitalsBlock& block) {
+        const VitalsBlockHeader& header = block.header;
+        if (header.first_ts >= from && header.last_ts <= to &&
+            (header.first_ts - from) / step == (header.last_ts - from) / step) {
+            bucket_add(buckets[(header.first_ts - from) / step], header.count,
+                       header.min, header.max, header.sum);
+            return;
+        }
+
+        BlockDecoder decoder(block);
+        VitalsSample sample;
+        while (decoder.next(sample) && sample.timestamp <= to) {
+            if (sample.timestamp >= from) {
+                bucket_add(buckets[(sample.timestamp - from) / step], 1,
+                           sample.value, sample.value, sample.value);
+            }
+        }
+    });
+}
+
+VitalsStoreStats VitalsStore::stats() const {
+    VitalsStoreStats stats = {};
+    stats.samples = samples_;
+    stats.hot_blocks = hot_count_;
+    stats.cold_blocks = cold_count_;
+    for (const OpenBlock& open : open_) {
+        if (open.block.header.count > 0) {
+            ++stats.open_blocks;
+            stats.payload_bits += open.block.header.bits;
+        }
+    }
+    for (size_t i = 0; i < hot_count_; ++i) {
+        stats.payload_bits += hot_[(hot_head_ + i) % hot_.size()].header.bits;
+    }
+    return stats;
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include "owlet_result.h"
+#include "block_storage.h"
+
+struct PropertiesResponse;
+
+// Size of one compressed block, in RAM and on the cold tier
+static constexpr size_t kVitalsBlockSize = 256;
+
+// Block header. Aggregates let queries skip or summarise a block without
+// decoding its payload. Sealed blocks carry a CRC so blocks torn by a power
+// cut on the cold tier are ignored.
+struct VitalsBlockHeader {
+    uint32_t magic;
+    uint32_t sequence;     // increases with every sealed block, used for recovery
+    uint32_t first_ts;
+    uint32_t last_ts;
+    float min;
+    float max;
+    float sum;
+    uint32_t crc;          // CRC-32 of the header (with crc = 0) and payload
+    uint16_t count;
+    uint16_t bits;         // payload bits in use
+    uint8_t series;
+    uint8_t reserved1[3];
+};
+
+static constexpr size_t kVitalsPayloadSize = kVitalsBlockSize - sizeof(VitalsBlockHeader);
+
+// Samples are packed as delta-of-delta timestamps followed by the XOR of the
+// value against the previous one (Gorilla encoding).
+struct VitalsBlock {
+    VitalsBlockHeader header;
+    uint8_t payload[kVitalsPayloadSize];
+};
+
+static_assert(sizeof(VitalsBlock) == kVitalsBlockSize, "VitalsBlock must fill exactly one block");
+
+struct VitalsSample {
+    uint32_t timestamp;
+    float value;
+};
+
+struct VitalsBucket {
+    uint32_t start;
+    uint32_t count;
+    float min;
+    float max;
+    float sum;
+
+    float mean() const { return count ? sum / count : 0.0f; }
+};
+
+struct VitalsStoreStats {
+    size_t samples;
+    size_t open_blocks;
+    size_t hot_blocks;
+    size_t cold_blocks;
+    size_t payload_bits;
+};
+
+// Compressed time-series store for vitals history.
+//
+// Each series has one open block that samples are appended to. Full blocks
+// are sealed into a fixed ring of `hot_blocks` in RAM; when that ring is full
+// the oldest block spills to `cold_storage` (a flash partition on target, a
+// file on host), or is dropped if no cold tier was given.
+//
+// The cold tier outlives reboots, so timestamps must be wall-clock seconds
+// (Unix time after SNTP sync), never uptime; with a cold tier, append()
+// rejects timestamps before 2020. Series ids are assigned in registration
+// order and are stored in every block, so register series in the same order
+// after a restart to read back blocks recovered from the cold tier.
+// Not thread-safe.
+class VitalsStore {
+public:
+    explicit VitalsStore(size_t hot_blocks, std::shared_ptr<BlockStorage> cold_storage = nullptr);
+    ~VitalsStore();
+
+    // Track a property by name; returns its series id
+    OwletResult<uint8_t> add_series(const std::string& property);
+    OwletStatus append(uint8_t series, uint32_t timestamp, float value);
+
+    // Append the numeric "value" of every registered property present in
+    // `properties`. Returns the number of samples appended.
+    size_t ingest(const PropertiesResponse& properties, uint32_t timestamp);
+
+    // Seal all open blocks and push every hot block to the cold tier
+    OwletStatus flush();
+
+    // Visit samples of `series` with from <= timestamp <= to, oldest first
+    OwletStatus query(uint8_t series, uint32_t from, uint32_t to,
+                      const std::function<void(const VitalsSample&)>& visitor);
+
+    // Aggregate samples into buckets of `step` seconds starting at `from`.
+    // Blocks that fall entirely inside one bucket are merged from their
+    // header without being decoded. At most 4096 buckets per query.
+    OwletStatus downsample(uint8_t series, uint32_t from, uint32_t to, uint32_t step,
+                           std::vector<VitalsBucket>& buckets);
+
+    VitalsStoreStats stats() const;
+
+private:
+    struct Encoder {
+        uint32_t prev_ts;
+        int64_t prev_delta;
+        uint32_t prev_value;
+        uint8_t prev_leading;
+        uint8_t prev_trailing;
+    };
+
+    struct OpenBlock {
+        VitalsBlock block;
+        Encoder encoder;
+    };
+
+    void start_block(OpenBlock& open, uint8_t series);
+    OwletStatus seal(OpenBlock& open);
+    OwletStatus spill_oldest();
+    OwletStatus write_cold(const VitalsBlock& block);
+    void recover();
+    OwletStatus for_each_block(uint8_t series, uint32_t from, uint32_t to,
+                               const std::function<void(const VitalsBlock&)>& visitor);
+
+    std::vector<std::string> series_names_;
+    std::vector<OpenBlock> open_;
+    std::vector<VitalsBlock> hot_;
+    size_t hot_head_;
+    size_t hot_count_;
+    std::shared_ptr<BlockStorage> cold_;
+    size_t cold_head_;
+    size_t cold_count_;
+    uint32_t next_sequence_;
+    size_t samples_;
+};